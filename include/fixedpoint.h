@@ -16,19 +16,79 @@
 #include <iostream> // cerr, clog
 #include <string>
 #include <vector> // in convert_through_native
+#include <map> // power_cache tables
+#include <memory> // shared_ptr
+#include <mutex> // power_cache lock
+#include <array> // Toom-3 evaluations
+#include <cstdint> // uint64_t limbs
+#include <cstddef> // size_t
 #include <type_traits> // SFINAE
-#include <cmath> // floor, ceil
+#include <cmath> // floor, ceil, frexp
+#include <limits> // floating point mantissa width
 #include <stdexcept> // runtime_exception
 #include <algorithm> // any, reverse, reverse_copy
 #include <iterator> // back_inserter
 #include <ostream> // operator << definition
 #include <istream> // operator >> definition
-#include <sstream> // in str() func
+#include <sstream> // radix prefix and expression tokenizers
+#include <system_error> // errc of from_chars and to_chars
+#include <cstring> // memcpy of serialized limbs, memchr of line splitting
+#include <thread> // parallel parsing of loaded lines
+#include <exception> // exception_ptr of parsing threads
+#include <fstream> // load_lines without memory mapping
+#include <cerrno> // errno of failed file operations
 
 #if ! ( defined(FIXEDPOINT_CASE_SENSITIVE) || defined(FIXEDPOINT_CASE_INSENSITIVE) )
 #define FIXEDPOINT_CASE_INSENSITIVE
 #endif
 
+#if ! defined(__SIZEOF_INT128__)
+#error "FIXEDPOINT_H: compiler support for unsigned __int128 is required"
+#endif
+
+// Multiplication algorithm thresholds, in limbs of the shorter operand:
+#ifndef FIXEDPOINT_KARATSUBA_THRESHOLD
+#define FIXEDPOINT_KARATSUBA_THRESHOLD (24)
+#endif
+#ifndef FIXEDPOINT_TOOM3_THRESHOLD
+#define FIXEDPOINT_TOOM3_THRESHOLD (200)
+#endif
+#ifndef FIXEDPOINT_NTT_THRESHOLD
+#define FIXEDPOINT_NTT_THRESHOLD (3000)
+#endif
+// Division switches to Newton iteration when both divisor and quotient have this many limbs:
+#ifndef FIXEDPOINT_NEWTON_THRESHOLD
+#define FIXEDPOINT_NEWTON_THRESHOLD (800)
+#endif
+// Radix conversion splits digit strings longer than this many limbs:
+#ifndef FIXEDPOINT_CONVERSION_THRESHOLD
+#define FIXEDPOINT_CONVERSION_THRESHOLD (40)
+#endif
+// Default memory budget of cached radix powers, in bytes:
+#ifndef FIXEDPOINT_POWER_CACHE_LIMIT
+#define FIXEDPOINT_POWER_CACHE_LIMIT (std::size_t(64) << 20)
+#endif
+// Vectorized digit parsing, disable with FIXEDPOINT_NO_SIMD:
+#if ! defined(FIXEDPOINT_NO_SIMD) && defined(__SSE4_2__)
+#define FIXEDPOINT_SIMD_SSE42
+#if defined(__AVX2__)
+#define FIXEDPOINT_SIMD_AVX2
+#endif
+#include <immintrin.h> // digit scanning and packing
+#endif
+// Memory mapped loading of files, disable with FIXEDPOINT_NO_MMAP:
+#if ! defined(FIXEDPOINT_NO_MMAP) && ( defined(__unix__) || defined(__APPLE__) )
+#define FIXEDPOINT_MMAP
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close
+#endif
+// Smallest part of a bulk input parsed by one thread, in bytes:
+#ifndef FIXEDPOINT_LOAD_CHUNK
+#define FIXEDPOINT_LOAD_CHUNK (std::size_t(1) << 20)
+#endif
+
 namespace fixedpoint{
 
 #if defined( FIXEDPOINT_CASE_INSENSITIVE ) && ! defined( FIXEDPOINT_CASE_SENSITIVE )
@@ -147,6 +207,17 @@ struct division_by_zero: public std::runtime_error{
     division_by_zero():std::runtime_error("division by zero"){}
 };
 
+/**
+ * @brief The number_overflow struct is an exception related to fixed_number struct
+ *
+ * If this exception is thrown, it means that the result of an operation
+ * has more whole digits than the fixed_number type can hold, or that
+ * a number is out of range of the native type it is converted to.
+ */
+struct number_overflow: public std::overflow_error{
+    number_overflow():std::overflow_error("result does not fit into the fixed number of digits"){}
+};
+
 /**
  * @brief The unsupported_operation struct is an exception related to number struct
  *
@@ -158,1360 +229,5579 @@ struct unsupported_operation: public std::runtime_error{
     unsupported_operation(const std::string & what):std::runtime_error(what){}
 };
 
+/**
+ * @brief Result of from_chars, like std::from_chars_result
+ *
+ * ptr points past the parsed characters, ec is std::errc() on success.
+ */
+struct from_chars_result{
+    const char * ptr;
+    std::errc ec;
+};
 
-template<unsigned char radix>
 /**
- * <b>The number struct represents the fixedpoint numbers</b>
- * <p>
- * Before using any functions provided by this library,
- * you must initialize its static member scale, you may use this code snippet:
- * @code
- * template<unsigned char radix>
- * std::size_t number<radix>::scale = 0;
- * @endcode
- * <p>
- * You can parametrise the numeral system used by template parameter.
- * The default numeral system is base-10, to set base-n numeral system
- * instantiate the template with n*.
- * <p>
- * You can select numeral interpretation strategy in strings
- * by defining a macro:
- * <ul>
- *  <li>FIXEDPOINT_CASE_INSENSITIVE for case insensitive interpretation</li>
- *  <li>FIXEDPOINT_CASE_SENSITIVE for case sensitive interpretation</li>
- * </ul>
- * The default is case insensitive interpretation.
- * The numerals take the following precedence, from lowest to highest value:
- * <ul>
- *  <li>numbers from 0 to 9</li>
- *  <li>letters 'a' to 'z' (lowercase) in alphabetical order</li>
- *  <li>letters 'A' to 'Z' (uppercase) in alphabetical order</li>
- *  <li>characters '#'(valued as 62 decimal) and '$'(valued as 63 decimal)</li>
- * </ul>
- * The lowercase letters are preferred for string representation in case
- * insensitive mode. Characters '#' and '$' are invalid for case insensitive
- * mode.
- * <p>
- * <p>
- * Notes:
- * <p>
- * <ol>
- * <li>implementation caveat - maximum supported system is base-36 (or base-64),
- * due to lack of suitable ASCII chaacters to express numerals</li>
- * <li><b>Known bug</b>: performing @code myVar1 *= myVar1; @endcode
- * results in an exception, use @code myVar1 = myVar1 * myVar1; @endcode
- * or @code myVar1.pow(2); //implicitly converts 2 to same type as myVar1 @endcode
- * instead.</li>
- * </ol>
+ * @brief Malformed line reported by parse_lines and load_lines
  */
-struct number{
+struct line_error{
+    std::size_t line; // 1-based line number
+    std::errc ec;
+};
 
-    /**
-     * @brief To what number of fractional places to perform division.
-     *
-     * Affects modulo as well - mudulo is performed to
-     * scale+number of fractional digits of the divisor precision.
-     */
-    static std::size_t scale;
+/**
+ * @brief Result of to_chars, like std::to_chars_result
+ *
+ * ptr points past the written characters, ec is std::errc() on success.
+ */
+struct to_chars_result{
+    char * ptr;
+    std::errc ec;
+};
 
-    /**
-     * @brief Default constructor
-     *
-     * Constructs a number of zero value and zero scale.
-     */
-    number():
-        cela_cast{digits[0]},
-        des_cast{},
-        isPositive(true)
-    {
-        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
-        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
+namespace detail{
+
+/**
+ * @brief Machine word holding several base-radix digits
+ */
+typedef std::uint64_t limb;
+
+/**
+ * @brief Double width word for intermediate products and quotients
+ */
+typedef unsigned __int128 dlimb;
+
+/**
+ * @brief Tells whether T is an integer type numbers convert to
+ *
+ * Unlike std::is_integral, includes the 128-bit types in strict ISO mode
+ * and excludes bool.
+ */
+template<typename T>
+struct is_native_integer: std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value>{};
+template<>
+struct is_native_integer<__int128>: std::true_type{};
+template<>
+struct is_native_integer<unsigned __int128>: std::true_type{};
+
+/**
+ * @brief Calculates how many base-radix digits fit into one limb
+ *
+ * The result is the largest k for which radix^k does not exceed 2^63,
+ * so a sum of two limbs and a carry never overflows the machine word.
+ * @param radix numeral system of the digits
+ * @return Number of digits per limb
+ */
+constexpr unsigned limb_digits(unsigned radix){
+    unsigned k = 0;
+    std::uint64_t p = 1;
+    while (p <= (std::uint64_t(1) << 63) / radix){
+        p *= radix;
+        ++k;
     }
-    /**
-     * @brief String constructor
-     *
-     * Key for source string format:
-     * <ul>
-     *  <li>s       First position for - sign (optional)</li>
-     *  <li>RR      Decimal digits of radix (optional, always couple with radix separator)</li>
-     *  <li>::      Radix separator (optional, always must be coupled with radix)</li>
-     *  <li>S       Second position for - sign (optional)</li>
-     *  <li>D...D   Digits of the whole part</li>
-     *  <li>p       Radix point - '.' or ',' character (optional, always couple with fractional part)</li>
-     *  <li>d...d   Digits of the fractional part (optional, always precede by radix point)</li>
-     * </li>
-     *
-     * If you don't specify fracnum, by default the size of the detected
-     * fractional part is taken and multiplied by ceil of source_radix/target_radix
-     * and the result of that operation is considered as fracnum (aka IMPLICIT STRATEGY).
-     *
-     * If you specify fracnum as a nonnegative integer that number is not modified
-     * in any way and fractional part is calculated to that size.
-     *
-     * If you specify fracnum as a negative integer, the implicit strategy is performed.
-     *
-     * Regardless of what is the value of fracnum, the resulting number is always
-     * stripped of leading and trailing zeroes.
-     *
-     * @param src   source string according to format sRR::SD...Dpd...d
-     * @param fracnum how many fractional digits to store after conversion
-     * @throw invalid_number_format upon misformatted number, further details in what() and cerr
-     * @throw radix_invalid when radix is specified incorrectly or is not supported
-     */
-    explicit number(const std::string & src, long long int fracnum = -1):
-        isPositive(src.find_first_of('-')==src.npos)
-    {
-        using namespace std::literals;
-        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
-        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
-        // basic format verification:
-        if (std::count_if(
-                    src.cbegin(),
-                    src.cend(),
-                    [](const char c){return values[static_cast<int>(c)]==-2;}
-                    ) > 1){
-            std::cerr << src
-                      << " contains too many decimal separators"
-                      << std::flush;
-            throw(invalid_number_format("contains more than one decimal separator"));
-        }
-        auto start = src.cbegin();
-        std::size_t rdx = radix;
-        if (*start=='-') ++start; // negative check already happened
-        if ((src.find_first_of(':'))!=src.npos){ // has radix specified
-            std::stringstream x("");
-            while(*start != ':'){
-                if(*start<'0' || '9'<*start) {
-                    std::cerr << src
-                              << " contains invalid characters in radix"
-                              << std::flush;
-                    throw(invalid_number_format("src's radix is ill formatted"));
-                }
-                x << *start;
-                ++start;
-            }
-            x >> rdx; // radix is always specified as decimal number
-            if ( rdx > MAX_RADIX || rdx < 2 ) {
-                throw(radix_invalid());
-            }
-            ++start; // goes to second colon
-            if (*start != ':'){
-                std::cerr << src
-                          << " is missing a colon in radix separator"
-                          << std::flush;
-                throw(invalid_number_format("missing 2nd colon in separator"));
-            }
-            ++start;
-        }
-        if ((!isPositive) && *start=='-'){
-            // - sign was not read yet
-            ++start;
-        }
-        // number validity check:
-        if (std::any_of(
-                    start,
-                    src.cend(),
-                    [rdx = static_cast<int>(rdx)](const char c){
-                    return (values[static_cast<int>(c)]==-1 ||
-                            (values[static_cast<int>(c)]>=rdx));
-                    }))
-        {
-            std::cerr << src
-                      << " contains invalid characters for radix "
-                      << rdx
-                      << std::flush;
-            throw(invalid_number_format("invalid characters found in input string"));
-        }
-        // get whole and decimal parts:
-        std::string whole,decimal;
-        bool onDecimal = false;
-        for (;start!=src.cend();++start){
-            if (onDecimal){
-                decimal += *start;
-            }
-            else{
-                if (values[static_cast<int>(*start)] == -2) onDecimal = true;
-                else whole += *start;
-            }
-        }
-        // reverse whole part (so it meets storage requirement):
-        std::reverse(whole.begin(), whole.end());
-        // convert here:
-        if (rdx == radix){
-            // only need to assign to members and maybe resize des_cast
-            cela_cast = std::move(whole);
-            des_cast = std::move(decimal);
-            if (fracnum >= 0) des_cast.resize(fracnum, digits[0]);
-        }
-        else{
-            // convert from base rdx to base radix:
-            // convert radix to base rdx:
-            if (fracnum < 0) fracnum = std::ceil(static_cast<double>(rdx)/radix)*decimal.size();
-            auto res = convert_with_vector(whole, decimal, rdx, fracnum);
-            cela_cast = std::move(res.first);
-            des_cast = std::move(res.second);
-        }
-        strip_zeroes();
+    return k;
+}
+
+/**
+ * @brief Calculates base^exponent in limb arithmetic
+ */
+constexpr limb limb_pow(limb base, unsigned exponent){
+    limb result = 1;
+    while (exponent-- > 0) result *= base;
+    return result;
+}
+
+/**
+ * @brief Number of bits of one digit for power of two radices
+ * @return log2(radix) if radix is a power of two, 0 otherwise
+ */
+constexpr unsigned limb_radix_bits(unsigned radix){
+    unsigned bits = 0;
+    while ((1u << bits) < radix) ++bits;
+    return ((1u << bits) == radix) ? bits : 0;
+}
+
+/**
+ * @brief Smallest root such that radix is a power of root
+ */
+constexpr unsigned radix_root(unsigned radix){
+    for (unsigned root = 2; root < radix; ++root){
+        unsigned p = root;
+        while (p < radix) p *= root;
+        if (p == radix) return root;
     }
+    return radix;
+}
 
-    /**
-     * @brief Integral type constructor
-     * @param x value to construct number with
-     */
-    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-    number(T x):
-        des_cast{},
-        isPositive(x>=0)
-    {
-        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
-        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
-        std::string rep = std::to_string(x); // obtain string representation
-        std::reverse(rep.begin(), rep.end()); // reverse string - BIG ENDIAN storage
-        if (!isPositive) rep.pop_back(); // get rid of - sign
-#if !(defined(FIXEDPOINT_CASE_INSENSITIVE) || defined(FIXEDPOINT_CASE_SENSITIVE))
-        // only perform the following
-        // if we can't suppose anything about digits[]
-        for (auto x = rep.begin(); x!=rep.end(); ++x){
-            // convert from digits 0-9 to whatever our encoding uses
-            *x = digits[*x-'0'];
-        }
-#endif
-        if (radix == 10){
-            cela_cast = rep;
-        }
-        else{
-            cela_cast = convert_with_vector(rep,"",10,0).first;
-        }
-        strip_zeroes();
+/**
+ * @brief Exponent k for which root^k == radix, 0 if there is none
+ */
+constexpr unsigned radix_exponent(unsigned radix, unsigned root){
+    unsigned k = 0, p = 1;
+    while (p < radix){
+        p *= root;
+        ++k;
     }
+    return (p == radix) ? k : 0;
+}
 
-    /**
-     * @brief Floating point type constructor
-     *
-     * Please note: Due to the limited resolution of the mantissa
-     * of floating point types, too large or too small numbers may end up
-     * converted with different values than expected. If this happens, you
-     * probably hit the limit of the mantissa's resolution.
-     * For correct conversion you might wish to consider using
-     * the string constructor instead.
-     * @param x value to construct number with
-     * @param scale how many fractional places to calculate (in target radix)
-     */
-    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_floating_point<T>()))>
-    explicit number(T x, unsigned int fracnum = 5):
-        isPositive(x>=0)
-    {
-        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
-        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
-        if (fracnum > 19){
-            std::cerr << "Max scale for floating point constructor is 19!" << std::flush;
-            fracnum = 19;
-        }
-        if (x < 0) x*=-1;
-        std::string whole, decimal;
-        whole = std::to_string(std::floor(x));
-        if (whole.find_first_of('.') != std::string::npos) {
-            whole.resize(whole.find_first_of('.'),'0');
-        }
-        std::reverse(whole.begin(), whole.end()); // reverse string - BIG ENDIAN storage
-        x -= std::floor(x);
-        for (int i = std::min(fracnum, static_cast<unsigned>(std::ceil(10.0/radix))); i>=0; --i) x*=10;
-        decimal = std::to_string(std::floor(x));
-        if (decimal.find_first_of('.') != std::string::npos) {
-            decimal.resize(decimal.find_first_of('.'),'0');
-        }
-#if !(defined(FIXEDPOINT_CASE_INSENSITIVE) || defined(FIXEDPOINT_CASE_SENSITIVE))
-        // only perform the following
-        // if we can't suppose anything about digits[]
-        for (auto x = whole.begin(); x!=whole.end(); ++x){
-            // convert from digits 0-9 to whatever our encoding uses
-            *x = digits[*x-'0'];
-        }
-        for (auto x = decimal.begin(); x!=decimal.end(); ++x){
-            // convert from digits 0-9 to whatever our encoding uses
-            *x = digits[*x-'0'];
-        }
+/**
+ * @brief Counts leading zero bits of a nonzero limb
+ */
+constexpr unsigned limb_clz(limb x){
+    unsigned n = 0;
+    while ((x & (limb(1) << 63)) == 0){
+        x <<= 1;
+        ++n;
+    }
+    return n;
+}
+
+/**
+ * @brief Translates digit characters to their values
+ *
+ * Stops at the first character that is not a digit of radix rdx, be it
+ * a radix point, a sign or the end of input. Radices up to 36 are
+ * validated and translated 32 (AVX2) or 16 (SSE4.2) characters at a time
+ * if enabled at compile time, the rest goes through the values table.
+ * @param out output for digit values, room for last - first of them
+ * @return Pointer to the first character that is not a digit
+ */
+inline const char * scan_digits(const char * first, const char * last, unsigned rdx, unsigned char * out){
+#if defined(FIXEDPOINT_SIMD_SSE42)
+    if (rdx <= 36){
+        // digits map to c - '0', letters to (c | fold) - 'a' + 10, everything else to 0xff
+#if defined(FIXEDPOINT_CASE_INSENSITIVE)
+        const char fold = 0x20;
+#else
+        const char fold = 0;
 #endif
-        if (radix == 10){
-            cela_cast = whole;
-            des_cast = decimal;
+#if defined(FIXEDPOINT_SIMD_AVX2)
+        {
+            const __m256i zero = _mm256_set1_epi8('0'), nine = _mm256_set1_epi8(9);
+            const __m256i a = _mm256_set1_epi8('a'), z = _mm256_set1_epi8(25), ten = _mm256_set1_epi8(10);
+            const __m256i lower = _mm256_set1_epi8(fold), top = _mm256_set1_epi8(static_cast<char>(rdx - 1));
+            for (; last - first >= 32; first += 32, out += 32){
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+                __m256i d = _mm256_sub_epi8(c, zero);
+                d = _mm256_or_si256(d, _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(d, nine), d), _mm256_set1_epi8(-1)));
+                __m256i l = _mm256_sub_epi8(_mm256_or_si256(c, lower), a);
+                l = _mm256_or_si256(_mm256_add_epi8(l, ten),
+                                    _mm256_xor_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(l, z), l), _mm256_set1_epi8(-1)));
+                const __m256i v = _mm256_min_epu8(d, l);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), v);
+                const unsigned valid = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(v, top), v)));
+                if (valid != 0xffffffffu) return first + __builtin_ctz(~valid);
+            }
         }
-        else{
-            auto res = convert_with_vector(whole,decimal,10,fracnum);
-            cela_cast = std::move(res.first);
-            des_cast = std::move(res.second);
+#endif
+        const __m128i zero = _mm_set1_epi8('0'), nine = _mm_set1_epi8(9);
+        const __m128i a = _mm_set1_epi8('a'), z = _mm_set1_epi8(25), ten = _mm_set1_epi8(10);
+        const __m128i lower = _mm_set1_epi8(fold), top = _mm_set1_epi8(static_cast<char>(rdx - 1));
+        for (; last - first >= 16; first += 16, out += 16){
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            __m128i d = _mm_sub_epi8(c, zero);
+            d = _mm_or_si128(d, _mm_xor_si128(_mm_cmpeq_epi8(_mm_min_epu8(d, nine), d), _mm_set1_epi8(-1)));
+            __m128i l = _mm_sub_epi8(_mm_or_si128(c, lower), a);
+            l = _mm_or_si128(_mm_add_epi8(l, ten),
+                             _mm_xor_si128(_mm_cmpeq_epi8(_mm_min_epu8(l, z), l), _mm_set1_epi8(-1)));
+            const __m128i v = _mm_min_epu8(d, l);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), v);
+            const unsigned valid = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, top), v)));
+            if (valid != 0xffffu) return first + __builtin_ctz(~valid);
         }
-        strip_zeroes();
     }
+#endif
+    for (; first != last; ++first, ++out){
+        const unsigned char c = static_cast<unsigned char>(*first);
+        const int v = (c < 128) ? values[c] : -1;
+        if (v < 0 || static_cast<unsigned>(v) >= rdx) break;
+        *out = static_cast<unsigned char>(v);
+    }
+    return first;
+}
 
-    number(const number &) = default;
-    number(number &&) = default;
-    number& operator =(const number &) = default;
-    number& operator =(number &&) = default;
+/**
+ * @brief Version of the binary format written by serialize
+ */
+constexpr unsigned char serial_version = 1;
 
-    // O(n) where n is number of digits in number
-    number& operator +=(const number & other){
-        if ( isPositive != other.isPositive ){
-            isPositive = ! isPositive; // make the signs match
-            operator-=(other); // do -this-other
-            isPositive = ! isPositive;
-            // flip the resulting sign so that the result is correct
-        }
-        else{
-            size_t boundary = std::min(des_cast.size(), other.des_cast.size());
-
-            // DESATINNA CAST
-            if (des_cast.size() < other.des_cast.size()){
-                // possibly partial copy
-                des_cast.append(other.des_cast,
-                                boundary,
-                                other.des_cast.size() - boundary);
-            }
-            int tmp, carry = 0;
-            int ourss, theirss;
-            for ( size_t i = boundary; i>0; --i ){ // easier than with iterators
-                ourss = static_cast<int>(des_cast[i-1]);
-                theirss = static_cast<int>(other.des_cast[i-1]);
-                tmp = values[ourss] + values[theirss] + carry;
-                carry = tmp / radix;
-                des_cast[i-1] = digits[tmp % radix];
-            }
-
-            // CELA CAST
-            if ( other.cela_cast.size() > cela_cast.size()){
-                cela_cast.resize( other.cela_cast.size(), digits[0] );
-            }
-            auto our = cela_cast.begin();
-            auto their = other.cela_cast.begin();
-            for ( ; our != cela_cast.end() ; ++our){
-                ourss = static_cast<int>(*our);
-                tmp = values[ ourss ] + carry;
-                if ( their != other.cela_cast.end() ){
-                    theirss = static_cast<int>( *( their++ ));
-                    tmp += values[ theirss ];
-                }
-                carry = tmp / radix;
-                *our = digits[ tmp % radix ];
+/**
+ * @brief Number of bytes of x in LEB128 encoding
+ */
+inline std::size_t varint_size(std::uint64_t x){
+    std::size_t n = 1;
+    for (; x >= 0x80; x >>= 7) ++n;
+    return n;
+}
 
-            }
-            if ( carry > 0 ){
-                cela_cast.push_back(digits[carry]);
-            }
+/**
+ * @brief Writes x in LEB128 encoding, 7 bits per byte with a continuation bit
+ * @return Pointer past the written bytes
+ */
+inline char * write_varint(char * out, std::uint64_t x){
+    for (; x >= 0x80; x >>= 7) *out++ = static_cast<char>((x & 0x7f) | 0x80);
+    *out++ = static_cast<char>(x);
+    return out;
+}
+
+/**
+ * @brief Reads a LEB128 encoded value
+ * @return Pointer past the value, nullptr if it is truncated or longer than 64 bits
+ */
+inline const char * read_varint(const char * first, const char * last, std::uint64_t & x){
+    x = 0;
+    for (unsigned shift = 0; first != last && shift < 64; shift += 7){
+        const std::uint64_t byte = static_cast<unsigned char>(*first++);
+        if (shift == 63 && byte > 1) return nullptr;
+        x |= (byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return first;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Copies n limbs to little endian bytes
+ */
+inline char * store_limbs(char * out, const limb * x, std::size_t n){
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(out, x, n * sizeof(limb));
+    return out + n * sizeof(limb);
+#else
+    for (std::size_t i = 0; i < n; ++i){
+        for (unsigned b = 0; b < sizeof(limb); ++b) *out++ = static_cast<char>(x[i] >> (8 * b));
+    }
+    return out;
+#endif
+}
+
+/**
+ * @brief Copies n limbs from little endian bytes
+ */
+inline const char * load_limbs(const char * in, limb * x, std::size_t n){
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(x, in, n * sizeof(limb));
+    return in + n * sizeof(limb);
+#else
+    for (std::size_t i = 0; i < n; ++i){
+        x[i] = 0;
+        for (unsigned b = 0; b < sizeof(limb); ++b) x[i] |= static_cast<limb>(static_cast<unsigned char>(*in++)) << (8 * b);
+    }
+    return in;
+#endif
+}
+
+/**
+ * @brief Vector of limbs that keeps short magnitudes inline
+ *
+ * Up to inline_capacity limbs (a magnitude of about 126 bits) are stored
+ * in the object itself, so small numbers never touch the heap; longer
+ * magnitudes move to a heap buffer transparently. Provides the part of
+ * the std::vector interface used by the arithmetic.
+ */
+class limb_vector{
+public:
+    typedef limb value_type;
+    typedef limb * iterator;
+    typedef const limb * const_iterator;
+
+    /**
+     * @brief Number of limbs stored without allocation
+     */
+    static constexpr std::size_t inline_capacity = 2;
+
+    limb_vector() noexcept:
+        ptr(local),
+        count(0),
+        capacity(inline_capacity)
+    {}
+    explicit limb_vector(std::size_t n, limb value = 0):
+        limb_vector()
+    {
+        assign(n, value);
+    }
+    template<typename It, typename = typename std::enable_if<!std::is_integral<It>::value>::type>
+    limb_vector(It first, It last):
+        limb_vector()
+    {
+        assign(first, last);
+    }
+    limb_vector(const limb_vector & other):
+        limb_vector()
+    {
+        assign(other.begin(), other.end());
+    }
+    limb_vector(limb_vector && other) noexcept:
+        limb_vector()
+    {
+        steal(other);
+    }
+    ~limb_vector(){
+        release();
+    }
+    limb_vector & operator =(const limb_vector & other){
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+    limb_vector & operator =(limb_vector && other) noexcept{
+        if (this != &other){
+            release();
+            ptr = local;
+            capacity = inline_capacity;
+            count = 0;
+            steal(other);
         }
-        // At worst 1 partial copy (extending the scale)
-        // or whatever -= does
-        strip_zeroes();
         return *this;
     }
 
-    number & operator -=(const number &other){
-        if ( isPositive != other.isPositive ){
-            number o1(other);
-            o1.isPositive = isPositive;
-            return *this +=( o1 );
-        }
-        //1 copy
-        number o1(other);
-        if(cmp_ignore_sig(o1) == -1){//odečítám větší (v abs hodnotě) od menšího, tak je prohodím
-            swap(o1);
-            isPositive = !isPositive;
-        }
-        //dále už předpokladam, že odečítám menší od většího
-        size_t boundary = o1.des_cast.size();
-        // DESATINNA CAST
-        if (des_cast.size() < boundary){
-            des_cast.resize( boundary, digits[0] );
+    std::size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    limb * data() noexcept { return ptr; }
+    const limb * data() const noexcept { return ptr; }
+    iterator begin() noexcept { return ptr; }
+    const_iterator begin() const noexcept { return ptr; }
+    iterator end() noexcept { return ptr + count; }
+    const_iterator end() const noexcept { return ptr + count; }
+    limb & operator [](std::size_t i) noexcept { return ptr[i]; }
+    const limb & operator [](std::size_t i) const noexcept { return ptr[i]; }
+    limb & back() noexcept { return ptr[count - 1]; }
+    const limb & back() const noexcept { return ptr[count - 1]; }
+
+    void clear() noexcept { count = 0; }
+    void pop_back() noexcept { --count; }
+    void push_back(limb x){
+        if (count == capacity) reserve(count + 1);
+        ptr[count++] = x;
+    }
+    void reserve(std::size_t n){
+        if (n <= capacity) return;
+        n = std::max(n, 2 * capacity);
+        limb * fresh = new limb[n];
+        std::copy(ptr, ptr + count, fresh);
+        release();
+        ptr = fresh;
+        capacity = n;
+    }
+    void resize(std::size_t n, limb value = 0){
+        reserve(n);
+        if (n > count) std::fill(ptr + count, ptr + n, value);
+        count = n;
+    }
+    void assign(std::size_t n, limb value){
+        count = 0;
+        resize(n, value);
+    }
+    template<typename It, typename = typename std::enable_if<!std::is_integral<It>::value>::type>
+    void assign(It first, It last){
+        // a range inside this vector never needs to grow it, so shifting it down is safe
+        const std::size_t n = std::distance(first, last);
+        reserve(n);
+        std::copy(first, last, ptr);
+        count = n;
+    }
+    iterator insert(const_iterator pos, std::size_t n, limb value){
+        const std::size_t at = pos - ptr;
+        reserve(count + n);
+        std::copy_backward(ptr + at, ptr + count, ptr + count + n);
+        std::fill(ptr + at, ptr + at + n, value);
+        count += n;
+        return ptr + at;
+    }
+    template<typename It, typename = typename std::enable_if<!std::is_integral<It>::value>::type>
+    iterator insert(const_iterator pos, It first, It last){
+        const std::size_t at = pos - ptr, n = std::distance(first, last);
+        reserve(count + n);
+        std::copy_backward(ptr + at, ptr + count, ptr + count + n);
+        std::copy(first, last, ptr + at);
+        count += n;
+        return ptr + at;
+    }
+    iterator erase(const_iterator first, const_iterator last){
+        const std::size_t at = first - ptr;
+        std::copy(ptr + (last - ptr), ptr + count, ptr + at);
+        count -= last - first;
+        return ptr + at;
+    }
+    void swap(limb_vector & other) noexcept{
+        if (ptr != local && other.ptr != other.local){
+            std::swap(ptr, other.ptr);
+            std::swap(count, other.count);
+            std::swap(capacity, other.capacity);
         }
-        int tmp, carry = 0;
-        for ( size_t i = boundary; i>0; --i ){ // easier than with iterators
-            tmp = values[static_cast<int>(des_cast[i-1])] - values[static_cast<int>(o1.des_cast[i-1])] + carry;
-            if(tmp < 0) {
-                carry = -1;
-                tmp +=radix;
-            }else {
-                carry = 0;
-            }
-            des_cast[i-1] = digits[tmp];
+        else{
+            limb_vector tmp(std::move(other));
+            other.steal(*this);
+            steal(tmp);
         }
+    }
 
-        // CELA CAST
-        if ( o1.cela_cast.size() > cela_cast.size()){
-            cela_cast.resize( o1.cela_cast.size(), digits[0] );
+private:
+    void release() noexcept{
+        if (ptr != local) delete[] ptr;
+    }
+    /**
+     * @brief Takes the contents of other, this must be empty and inline
+     */
+    void steal(limb_vector & other) noexcept{
+        if (other.ptr == other.local){
+            std::copy(other.local, other.local + other.count, local);
         }
-        size_t index = 0;
-        size_t first_digit = 0;
-        for ( index = 0; index < cela_cast.size() ;index++){
-            tmp = values[static_cast<int>( cela_cast.at(index))] + carry;
-            if ( index < o1.cela_cast.size() ){
-                tmp -= values[static_cast<int>( o1.cela_cast.at(index)) ];
-            }
-            if(tmp < 0) {
-                carry = -1;
-                tmp +=radix;
-            }else {
-                carry = 0;
-            }
-            if(0 != tmp) first_digit = index;
-            cela_cast.at(index) =  digits[tmp];
-
+        else{
+            ptr = other.ptr;
+            capacity = other.capacity;
+            other.ptr = other.local;
+            other.capacity = inline_capacity;
         }
-        cela_cast.resize(first_digit + 1, digits[0] );
-        strip_zeroes();
-        // At worst 1 copy
-        // or 1 copy and whatever += does
-        return *this;
+        count = other.count;
+        other.count = 0;
     }
 
-    number & operator *=(const number & other){
-        // handle sign:
-        isPositive = (isPositive == other.isPositive);
-        // trivial case - one of the numbers is (-)1 or 0:
-        number one(1), zero(0);
-        if ( (cmp_ignore_sig(one) == 0) ||
-             (other.cmp_ignore_sig(zero) == 0) ){
-            cela_cast = other.cela_cast;
-            des_cast = other.des_cast;
-        }
-        else if ( (other.cmp_ignore_sig(one) == 0) ||
-                  (cmp_ignore_sig(zero) == 0) ){
-            return *this;
+    limb * ptr; // local or a heap buffer of capacity limbs
+    std::size_t count;
+    std::size_t capacity;
+    limb local[inline_capacity];
+};
+
+template<std::uint32_t P, std::uint32_t G>
+/**
+ * @brief Number theoretic transform modulo prime P
+ *
+ * P must be of the form c*2^k+1 and G must be a primitive root modulo P,
+ * transforms of length up to 2^k are supported.
+ */
+struct ntt_prime{
+    static constexpr std::uint32_t modulus = P;
+
+    static std::uint32_t mul(std::uint32_t a, std::uint32_t b){
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(a) * b % P);
+    }
+
+    static std::uint32_t pow(std::uint32_t a, std::uint64_t e){
+        std::uint32_t result = 1;
+        for (; e != 0; e >>= 1, a = mul(a, a)){
+            if (e & 1) result = mul(result, a);
         }
-        else{
-            //čísla reprezentuji jako zlomky x/y, kde y má formát 100...0
-            //pocet desetinych míst
-            size_t decimals = std::max(des_cast.size(), other.des_cast.size());
-            //ocekavana maximalni velikost výsledku
-            size_t size = (decimals + cela_cast.size()) + (decimals + other.cela_cast.size());
-            // konecna velkost desatinnej casti:
-            size_t endfrac = std::max(des_cast.size(), other.des_cast.size());
-
-            const number a(*this);
-            const number& b = other;
-
-            const size_t dec_point = 2 * (decimals);
-            des_cast.clear();
-            des_cast.resize(dec_point, digits[0] );
-            cela_cast.clear();
-            cela_cast.resize(size, digits[0] );
-
-            auto product = [&dec_point, this](size_t i) -> char&{
-                if(i <dec_point){
-                    i = dec_point - i -1;
-                    return des_cast.at(i);
-                }else{
-                    i = i - dec_point;
-                    return cela_cast.at(i);
-                }
-            };
-            auto get = [&decimals](const number &from,size_t i) -> const char&{
-                if(i <decimals){
-                    i = decimals - i -1;
-                    if(i < from.des_cast.size()) return from.des_cast.at(i);
-                    //implicitní nuly
-                    else return digits[0];
-                }else{
-                    i = i - decimals;
-                    if(i < from.cela_cast.size()) return from.cela_cast.at(i);
-                    //implicitní nuly
-                    else return digits[0];
+        return result;
+    }
 
+    /**
+     * @brief In place forward or inverse transform of x
+     * @param x values smaller than P
+     * @param n length of x, a power of two
+     * @param inverse whether to perform the inverse transform (including the 1/n factor)
+     */
+    static void transform(std::uint32_t * x, std::size_t n, bool inverse){
+        // bit reversal permutation:
+        for (std::size_t i = 1, j = 0; i < n; ++i){
+            std::size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(x[i], x[j]);
+        }
+        std::vector<std::uint32_t> twiddle(n / 2);
+        for (std::size_t len = 2; len <= n; len <<= 1){
+            const std::size_t half = len / 2;
+            std::uint32_t w = pow(G, (P - 1) / len);
+            if (inverse) w = pow(w, P - 2);
+            twiddle[0] = 1;
+            for (std::size_t j = 1; j < half; ++j) twiddle[j] = mul(twiddle[j - 1], w);
+            for (std::size_t i = 0; i < n; i += len){
+                for (std::size_t j = 0; j < half; ++j){
+                    std::uint32_t u = x[i + j], v = mul(x[i + j + half], twiddle[j]);
+                    x[i + j] = (u + v >= P) ? u + v - P : u + v;
+                    x[i + j + half] = (u >= v) ? u - v : u + P - v;
                 }
-            };
-
-            const size_t p = b.cela_cast.size() + decimals;
-            const size_t q = a.cela_cast.size() + decimals;
-            for(size_t b_i = 0; b_i < p; b_i++){
-                unsigned char carry= 0;
-                for(size_t a_i = 0; a_i < q; a_i++){
-                    unsigned long tmp = values[static_cast<int>(product(a_i + b_i))];
-                    tmp += carry + values[static_cast<int>(get(a, a_i ))] * values[static_cast<int>(get(b, b_i))];
-                    carry = tmp / radix;
-                    product(a_i + b_i) = digits[tmp % radix];
-                }
-                unsigned long tmp = values[static_cast<int>(product(b_i + q))];
-                tmp += carry;
-                product(b_i + q) = digits[tmp];
             }
-            size_t pos = cela_cast.find_last_not_of(digits[0]);
-            if(pos != cela_cast.npos) pos += 1;
-            else pos = 1;
-            cela_cast.resize(pos, digits[0]);
-            des_cast.resize(endfrac, digits[0]);
         }
-        strip_zeroes();
-        return *this;
+        if (inverse){
+            const std::uint32_t scale = pow(static_cast<std::uint32_t>(n % P), P - 2);
+            for (std::size_t i = 0; i < n; ++i) x[i] = mul(x[i], scale);
+        }
     }
 
     /**
-     * @brief Divides number
-     * @param other divisor
-     * @return Reference to *this
-     * @throw division_by_zero if divisor is zero
+     * @brief Calculates the cyclic convolution of a and b modulo P
+     * @param result output for n residues of the convolution
+     * @param a operand limbs
+     * @param an length of a
+     * @param b operand limbs
+     * @param bn length of b
+     * @param n transform length, a power of two not smaller than an+bn-1
      */
-    number & operator /=(const number &other){
-        // handle signs here:
-        isPositive = (isPositive == other.isPositive);
-        div_or_mod(other,true);
-        strip_zeroes();
-        return *this;
+    static void convolution(std::uint32_t * result,
+                            const limb * a, std::size_t an,
+                            const limb * b, std::size_t bn,
+                            std::size_t n){
+        std::fill(result, result + n, 0);
+        for (std::size_t i = 0; i < an; ++i) result[i] = static_cast<std::uint32_t>(a[i] % P);
+        transform(result, n, false);
+        if (a == b && an == bn){
+            // squaring, a single forward transform suffices
+            for (std::size_t i = 0; i < n; ++i) result[i] = mul(result[i], result[i]);
+        }
+        else{
+            std::vector<std::uint32_t> other(n, 0);
+            for (std::size_t i = 0; i < bn; ++i) other[i] = static_cast<std::uint32_t>(b[i] % P);
+            transform(other.data(), n, false);
+            for (std::size_t i = 0; i < n; ++i) result[i] = mul(result[i], other[i]);
+        }
+        transform(result, n, true);
     }
+};
 
-    /**
-     * @brief Computes modulo of number
-     * @param other divisor
-     * @return Reference to *this
-     * @throw division_by_zero if divisor is zero
-     */
-    number & operator %=(const number &other){
-        // modulo has the sign of first operand
-        div_or_mod(other,false);
-        strip_zeroes();
-        return *this;
+template<std::uint32_t P, std::uint32_t G>
+constexpr std::uint32_t ntt_prime<P, G>::modulus;
+
+// Primes for NTT multiplication, all above 2^30 with transform length at least 2^24.
+// Their product exceeds 2^150 > 2^23 * (2^63)^2, so every coefficient of
+// a convolution of limbs is recovered exactly by the chinese remainder theorem.
+typedef ntt_prime<2013265921u, 31> ntt_prime0;
+typedef ntt_prime<1811939329u, 13> ntt_prime1;
+typedef ntt_prime<2113929217u, 5> ntt_prime2;
+typedef ntt_prime<2130706433u, 3> ntt_prime3;
+typedef ntt_prime<1711276033u, 29> ntt_prime4;
+
+/**
+ * @brief Longest supported NTT, limited by the primes above
+ */
+constexpr std::size_t ntt_max_length = std::size_t(1) << 24;
+
+/**
+ * @brief Process-wide cache of powers used by radix conversion
+ *
+ * A table is kept per target radix and source unit, entry i holds
+ * unit^(2^i) in limbs of the target radix. Tables only grow and their
+ * entries are immutable and shared, so a conversion keeps using its copy
+ * even if the cache is cleared meanwhile. All members are thread safe.
+ */
+class power_cache{
+public:
+    typedef std::vector<std::shared_ptr<const limb_vector>> table;
 
+    static power_cache & instance(){
+        static power_cache cache;
+        return cache;
     }
 
-    number& operator ++(){
-        operator+=(1); // 1 will be implicitly converted to number
-        return *this;
+    /**
+     * @brief Returns the cached table, empty if there is none
+     */
+    table get(unsigned radix, limb unit){
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = tables.find(std::make_pair(radix, unit));
+        return (it == tables.end()) ? table() : it->second;
     }
-    number& operator --(){
-        operator-=(1); // 1 will be implicitly converted to number
-        return *this;
+
+    /**
+     * @brief Stores a table extending the cached one, unless it exceeds the budget
+     */
+    void put(unsigned radix, limb unit, const table & powers){
+        std::lock_guard<std::mutex> guard(lock);
+        table & cached = tables[std::make_pair(radix, unit)];
+        if (powers.size() <= cached.size()){
+            // another conversion stored at least as many powers meanwhile
+            if (cached.empty()) tables.erase(std::make_pair(radix, unit));
+            return;
+        }
+        std::size_t added = 0;
+        for (std::size_t i = cached.size(); i < powers.size(); ++i){
+            added += powers[i]->size() * sizeof(limb);
+        }
+        if (used + added > budget){
+            if (cached.empty()) tables.erase(std::make_pair(radix, unit));
+            return;
+        }
+        cached.insert(cached.end(), powers.begin() + cached.size(), powers.end());
+        used += added;
     }
-    number operator ++(int){
-        number copy(*this);
-        operator++();
-        return copy;
+
+    void set_limit(std::size_t bytes){
+        std::lock_guard<std::mutex> guard(lock);
+        budget = bytes;
+        if (used > budget){
+            tables.clear();
+            used = 0;
+        }
     }
-    number operator --(int){
-        number copy(*this);
-        operator--();
-        return copy;
+
+    std::size_t limit(){
+        std::lock_guard<std::mutex> guard(lock);
+        return budget;
     }
 
-    bool operator <(const number & rhs) const{
-        if (rhs.isPositive && !isPositive) return true;
-        if (isPositive && ! rhs.isPositive) return false;
-        if (isPositive) return cmp_ignore_sig(rhs)<0;
-        return cmp_ignore_sig(rhs)>0;
+    std::size_t usage(){
+        std::lock_guard<std::mutex> guard(lock);
+        return used;
     }
 
-    bool operator ==(const number & rhs) const{
-        bool tmpResult = ( isPositive == rhs.isPositive);
-        if ( tmpResult ){
-            return cmp_ignore_sig(rhs) == 0;
-        }
-        return tmpResult;
+    void clear(){
+        std::lock_guard<std::mutex> guard(lock);
+        tables.clear();
+        used = 0;
     }
 
+private:
+    power_cache():
+        used(0),
+        budget(FIXEDPOINT_POWER_CACHE_LIMIT)
+    {}
+
+    std::mutex lock;
+    std::map<std::pair<unsigned, limb>, table> tables;
+    std::size_t used; // bytes of limbs in tables
+    std::size_t budget;
+};
+
+template<unsigned char radix>
+/**
+ * @brief Low level arithmetic on arrays of limbs
+ *
+ * Every limb holds digits base-radix digits, so the limbs are digits
+ * of a base-(radix^digits) number. Arrays are stored LITTLE ENDIAN
+ * (least significant limb first) and are passed as pointer and length.
+ * Unless stated otherwise the result array may alias the operands.
+ */
+struct limb_arith{
+    static_assert(FIXEDPOINT_KARATSUBA_THRESHOLD >= 4, "FIXEDPOINT_KARATSUBA_THRESHOLD must be at least 4");
+    static_assert(FIXEDPOINT_TOOM3_THRESHOLD >= 5, "FIXEDPOINT_TOOM3_THRESHOLD must be at least 5");
+    static_assert(FIXEDPOINT_NTT_THRESHOLD >= 1, "FIXEDPOINT_NTT_THRESHOLD must be at least 1");
+    static_assert(FIXEDPOINT_NEWTON_THRESHOLD >= 2, "FIXEDPOINT_NEWTON_THRESHOLD must be at least 2");
+    static_assert(FIXEDPOINT_CONVERSION_THRESHOLD >= 1, "FIXEDPOINT_CONVERSION_THRESHOLD must be at least 1");
+
     /**
-     * @brief Calculates exponent-th power of number
-     * @param exponent  which power to calculate
-     * @return Reference to *this
-     * @throw unsupported_operation when attemted to power with fractional number
+     * @brief Number of base-radix digits stored in one limb
      */
-    number& pow(const number & exponent){
-        // kontrola desatinnej casti:
-        if(! std::all_of(exponent.des_cast.cbegin(),
-                         exponent.des_cast.cend(),
-                         [](const char x){return x==digits[0];}
-                         )){
-            throw unsupported_operation("Only integer exponent is suported for power function!");
-        }
-        // fast path for exponent 0
-        if(exponent.cmp_ignore_sig(number()) == 0){
-            operator=(number(1));
-        }
-        // fast path for powerbases 0 and (-)1
-        else if(cmp_ignore_sig(number())==0 || cmp_ignore_sig(number(1))==0){
-            if (! isPositive) { // 0 is treated as positive, therefore must be -1
-                isPositive = ((exponent%number(2)).cmp_ignore_sig(number())==0);
-            }
-        }
-        else{
-            //vyřeším záporný exponent
-            number expCopy(exponent);
-            number others(1), help;
-            number one(1),two(2);
-            if(!expCopy.isPositive){
-                // convert the problem to positive power of inverse number
-                expCopy.isPositive = true;
-                (*this) = one/(*this);
-            }
-            // divide and conquer - halve the exponent in each pass
-            std::size_t scalebak = scale;
-            scale = 0; // we need wholepart division for next part
-            while(expCopy > one){
+    static constexpr unsigned digits = limb_digits(radix);
+
+    /**
+     * @brief Value of one unit in the next limb, radix^digits
+     */
+    static constexpr limb base = limb_pow(radix, digits);
 
-                if(expCopy%two == one) others *= (*this);
-                help = (*this);
-                operator*=(help);
-                expCopy/=two;
+    /**
+     * @brief Shift that moves the top bit of base to bit 63
+     */
+    static constexpr unsigned norm_shift = limb_clz(base);
+
+    /**
+     * @brief Bits per digit if radix is a power of two, 0 otherwise
+     *
+     * For such radices every limb is a bit field of digits*radix_bits
+     * bits and scaling by powers of radix reduces to shifts and masks.
+     */
+    static constexpr unsigned radix_bits = limb_radix_bits(radix);
+
+    /**
+     * @brief Precomputed reciprocal of the normalized base
+     *
+     * floor((2^128-1) / (base << norm_shift)) - 2^64, see
+     * N. Möller, T. Granlund: Improved division by invariant integers.
+     */
+    static constexpr limb base_inv = static_cast<limb>(
+                ~static_cast<dlimb>(0) / (base << norm_shift)
+                - (static_cast<dlimb>(1) << 64));
+
+    /**
+     * @brief Calculates radix^n for n < digits from a precomputed table
+     */
+    static limb power(unsigned n){
+        static const struct power_table{
+            limb value[digits];
+            power_table(){
+                limb p = 1;
+                for (unsigned i = 0; i < digits; ++i){
+                    value[i] = p;
+                    p *= radix;
+                }
             }
-            scale = scalebak; // revert to original scale
-            operator*=(others);
-        }
-        strip_zeroes();
-        return *this;
+        } table;
+        return table.value[n];
     }
 
     /**
-     * @brief Floors the number
-     * @return Reference to *this
+     * @brief Number of base-radix digits of x, 0 for x == 0
+     *
+     * The count is looked up by the bit length of x and corrected
+     * by a single comparison instead of dividing x digit by digit.
      */
-    number& floor(){
-        if( !std::all_of( des_cast.cbegin(),
-                          des_cast.cend(),
-                          [](char x){return x==digits[0];}) ){
-            if (! isPositive){
-                operator--();
+    static unsigned digit_count(limb x){
+        static const struct length_table{
+            unsigned count[65]; // digits of 2^(bits-1)
+            limb bound[65];     // radix^count, or a bound no limb reaches
+            length_table(){
+                count[0] = 0;
+                bound[0] = ~limb(0);
+                for (unsigned bits = 1; bits <= 64; ++bits){
+                    count[bits] = 0;
+                    for (limb y = limb(1) << (bits - 1); y != 0; y /= radix) ++count[bits];
+                    bound[bits] = (count[bits] < digits) ? power(count[bits]) : ~limb(0);
+                }
             }
-        }
-        des_cast.clear();
-        return *this;
+        } table;
+        const unsigned bits = (x == 0) ? 0 : 64 - __builtin_clzll(x);
+        return table.count[bits] + (x >= table.bound[bits]);
     }
 
     /**
-     * @brief Ceils the number
-     * @return Reference to *this
+     * @brief Packs n <= digits digit values, most significant first, into a limb
+     *
+     * With SSE4.2 enabled at compile time blocks of 16 and 8 digits are
+     * combined pairwise by multiply-add instructions instead of one
+     * digit at a time.
      */
-    number& ceil(){
-        if( !std::all_of( des_cast.cbegin(),
-                          des_cast.cend(),
-                          [](char x){return x==digits[0];}) ){
-            if (isPositive){
-                operator++();
+    static limb pack_digits(const unsigned char * v, unsigned n){
+        limb acc = 0;
+        unsigned i = 0;
+#if defined(FIXEDPOINT_SIMD_SSE42)
+        // pairs of digits to 16 bits, then 4 digits to 32 bits and 8 digits to 64 bits
+        constexpr limb r2 = limb_pow(radix, 2), r4 = limb_pow(radix, 4), r8 = limb_pow(radix, 8);
+        const __m128i w1 = _mm_set1_epi16(static_cast<short>(0x100 | radix));
+        const __m128i w2 = _mm_set1_epi32(static_cast<int>(0x10000 | r2));
+        const __m128i w4 = _mm_set1_epi32(static_cast<int>(r4));
+        auto combine = [&](__m128i x){
+            x = _mm_madd_epi16(_mm_maddubs_epi16(x, w1), w2);
+            return _mm_add_epi64(_mm_mul_epu32(x, w4), _mm_srli_epi64(x, 32));
+        };
+        if (digits >= 16){
+            for (; i + 16 <= n; i += 16){
+                const __m128i x = combine(_mm_loadu_si128(reinterpret_cast<const __m128i *>(v + i)));
+                const limb high = static_cast<limb>(_mm_cvtsi128_si64(x));
+                const limb low = static_cast<limb>(_mm_extract_epi64(x, 1));
+                acc = (acc * r8 + high) * r8 + low;
             }
         }
-        des_cast.clear();
-        return *this;
+        for (; i + 8 <= n; i += 8){
+            const __m128i x = combine(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + i)));
+            acc = acc * r8 + static_cast<limb>(_mm_cvtsi128_si64(x));
+        }
+#endif
+        for (; i < n; ++i) acc = acc * radix + v[i];
+        return acc;
     }
 
     /**
-     * @brief Truncates the number
-     * @return Reference to *this
+     * @brief Splits a double limb into a quotient and remainder by base
+     * @param x value to split, must be smaller than base*2^64
+     * @param rem output for x % base
+     * @return x / base
      */
-    number& trunc(){
-        des_cast.clear();
-        return *this;
+    static limb divmod_base(dlimb x, limb & rem){
+        if ((base & (base - 1)) == 0){
+            // power of two radix, plain bit operations
+            rem = static_cast<limb>(x) & (base - 1);
+            return static_cast<limb>(x >> (63 - norm_shift));
+        }
+        const limb d = base << norm_shift;
+        x <<= norm_shift;
+        limb u1 = static_cast<limb>(x >> 64), u0 = static_cast<limb>(x);
+        dlimb q = static_cast<dlimb>(base_inv) * u1 + x;
+        limb q1 = static_cast<limb>(q >> 64) + 1, q0 = static_cast<limb>(q);
+        limb r = u0 - q1 * d;
+        if (r > q0){
+            --q1;
+            r += d;
+        }
+        if (r >= d){
+            ++q1;
+            r -= d;
+        }
+        rem = r >> norm_shift;
+        return q1;
     }
 
     /**
-     * @brief Returns string representation of the object
-     * @return  A newly constructed string
+     * @brief r = a + b, all of length n
+     * @return Carry out of the most significant limb (0 or 1)
      */
-    std::string str() const{
-        std::stringstream acc("");
-        std::string reversewhole;
-        reversewhole.append(cela_cast.crbegin(), cela_cast.crend());
-        acc << static_cast<unsigned int>(radix) << "::";
-        if( ! isPositive ) acc << "-";
-        acc << reversewhole;
-        if( ! des_cast.empty() ){
-            acc << "." << des_cast;
-        }
-        std::string result(acc.str());
-        return result;
+    static limb add_n(limb * r, const limb * a, const limb * b, std::size_t n){
+        limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            limb tmp = a[i] + b[i] + carry;
+            carry = (tmp >= base);
+            r[i] = carry ? tmp - base : tmp;
+        }
+        return carry;
     }
 
     /**
-     * @brief Evaluates an expression in postfix (reverse polish) notation
+     * @brief r = a + b, where a has length n and b is a single limb
+     * @return Carry out of the most significant limb (0 or 1)
+     */
+    static limb add_1(limb * r, const limb * a, std::size_t n, limb b){
+        for (std::size_t i = 0; i < n; ++i){
+            limb tmp = a[i] + b;
+            b = (tmp >= base);
+            r[i] = b ? tmp - base : tmp;
+        }
+        return b;
+    }
+
+    /**
+     * @brief r = a - b, all of length n
+     * @return Borrow out of the most significant limb (0 or 1)
+     */
+    static limb sub_n(limb * r, const limb * a, const limb * b, std::size_t n){
+        limb borrow = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            limb sub = b[i] + borrow;
+            borrow = (a[i] < sub);
+            r[i] = borrow ? a[i] + base - sub : a[i] - sub;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief r = a - b, where a has length n and b is a single limb
+     * @return Borrow out of the most significant limb (0 or 1)
+     */
+    static limb sub_1(limb * r, const limb * a, std::size_t n, limb b){
+        for (std::size_t i = 0; i < n; ++i){
+            limb sub = b;
+            b = (a[i] < sub);
+            r[i] = b ? a[i] + base - sub : a[i] - sub;
+        }
+        return b;
+    }
+
+    /**
+     * @brief Compares a and b, both of length n
+     * @return 0 if equal, n<0 if a<b, n>0 if a>b
+     */
+    static int cmp_n(const limb * a, const limb * b, std::size_t n){
+        while (n > 0){
+            --n;
+            if (a[n] != b[n]) return (a[n] > b[n]) ? 1 : -1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief r = a * b, where a has length n and b is a single limb
+     * @return Most significant limb of the product
+     */
+    static limb mul_1(limb * r, const limb * a, std::size_t n, limb b){
+        limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            carry = divmod_base(static_cast<dlimb>(a[i]) * b + carry, r[i]);
+        }
+        return carry;
+    }
+
+    /**
+     * @brief r += a * b, where r and a have length n and b is a single limb
+     * @return Limb to be added above the most significant limb of r
+     */
+    static limb addmul_1(limb * r, const limb * a, std::size_t n, limb b){
+        limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            carry = divmod_base(static_cast<dlimb>(a[i]) * b + r[i] + carry, r[i]);
+        }
+        return carry;
+    }
+
+    /**
+     * @brief r -= a * b, where r and a have length n and b is a single limb
+     * @return Limb to be subtracted above the most significant limb of r
+     */
+    static limb submul_1(limb * r, const limb * a, std::size_t n, limb b){
+        limb borrow = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            limb low;
+            limb high = divmod_base(static_cast<dlimb>(a[i]) * b + borrow, low);
+            borrow = high + (r[i] < low);
+            r[i] = (r[i] < low) ? r[i] + base - low : r[i] - low;
+        }
+        return borrow;
+    }
+
+    /**
+     * @brief q = a / d, where a has length n and d is a nonzero single limb
+     * @return Remainder of the division
+     */
+    static limb divrem_1(limb * q, const limb * a, std::size_t n, limb d){
+        dlimb rem = 0;
+        while (n > 0){
+            --n;
+            dlimb tmp = rem * base + a[n];
+            q[n] = static_cast<limb>(tmp / d);
+            rem = tmp % d;
+        }
+        return static_cast<limb>(rem);
+    }
+
+    /**
+     * @brief r = a * radix^k, where a has length n and k < digits
+     * @return Most significant limb of the product
+     */
+    static limb mul_pow(limb * r, const limb * a, std::size_t n, unsigned k){
+        if (radix_bits == 0) return mul_1(r, a, n, power(k));
+        const unsigned shift = k * radix_bits, width = digits * radix_bits;
+        limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            limb tmp = a[i];
+            r[i] = ((tmp << shift) & (base - 1)) | carry;
+            carry = tmp >> (width - shift);
+        }
+        return carry;
+    }
+
+    /**
+     * @brief q = a / radix^k, where a has length n and k < digits
+     * @return Remainder of the division
+     */
+    static limb divrem_pow(limb * q, const limb * a, std::size_t n, unsigned k){
+        if (radix_bits == 0) return divrem_1(q, a, n, power(k));
+        if (n == 0) return 0;
+        const unsigned shift = k * radix_bits, width = digits * radix_bits;
+        const limb mask = (limb(1) << shift) - 1, rem = a[0] & mask;
+        for (std::size_t i = 0; i + 1 < n; ++i){
+            q[i] = (a[i] >> shift) | ((a[i + 1] & mask) << (width - shift));
+        }
+        q[n - 1] = a[n - 1] >> shift;
+        return rem;
+    }
+
+    /**
+     * @brief Calculates x / radix^k for k < digits
+     */
+    static dlimb div_pow(dlimb x, unsigned k){
+        if (radix_bits != 0) return x >> (k * radix_bits);
+        return x / power(k);
+    }
+
+    /**
+     * @brief Remainder of a / d, where a has length n and d is a nonzero single limb
+     */
+    static limb mod_1(const limb * a, std::size_t n, limb d){
+        dlimb rem = 0;
+        while (n > 0){
+            --n;
+            rem = (rem * base + a[n]) % d;
+        }
+        return static_cast<limb>(rem);
+    }
+
+    /**
+     * @brief Long division of a by b, Knuth's algorithm D
      *
-     * Expression format rules:
-     * <ul>
-     *  <li>Separate tokens (functions, numbers, operators) by space</li>
-     *  <li>Denote function names with a leading '@' char
-     * (in certain radices, the function name itself is a valid number)</li>
-     *  <li>Write numbers according to the format specified in string constructor's documentation</li>
-     * </ul>
-     * @return Number containing the result of the evaluated expression
-     * @throw invalid_expression_format with details of error provided by what() and printed to cerr
-     * @throw (whatever the string constructor might throw)
-     * @throw (whatever the functions or operations performed might throw)
+     * Both operands are normalized so that the most significant limb of
+     * the divisor is at least base/2, then every quotient limb is
+     * estimated from the top two limbs of the partial remainder and
+     * corrected at most twice.
+     * @param q output for an-bn+1 limbs of the quotient
+     * @param r output for bn limbs of the remainder
+     * @param a dividend of length an
+     * @param b divisor of length bn, most significant limb must be nonzero
+     * @param scratch work space for an+bn+1 limbs, allocated if null
      */
-    static number eval_postfix(const std::string & expr){
-        using namespace std::literals;
-        std::vector<number> stack;
-        std::istringstream tokenizer(expr);
-        std::string tmp{};
-        number a;
-        std::string::const_iterator y;
-        while( tokenizer >> tmp ){
-            if( tmp.back() == '(') tmp.pop_back();
-            if(tmp == "+"){
-                if(stack.size() < 2){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                a = std::move(stack.back()); stack.pop_back();
-                stack.back()+=a;
-            }
-            else if(tmp == "-"){
-                if(stack.size() < 2){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                a = std::move(stack.back()); stack.pop_back();
-                stack.back()-=a;
-            }
-            else if(tmp == "*"){
-                if(stack.size() < 2){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                a = std::move(stack.back()); stack.pop_back();
-                stack.back()*=a;
-            }
-            else if(tmp == "/"){
-                if(stack.size() < 2){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                a = std::move(stack.back()); stack.pop_back();
-                stack.back()/=a;
+    static void divrem(limb * q, limb * r,
+                       const limb * a, std::size_t an,
+                       const limb * b, std::size_t bn,
+                       limb * scratch = nullptr){
+        if (bn == 1){
+            r[0] = divrem_1(q, a, an, b[0]);
+            return;
+        }
+        limb_vector allocated;
+        if (scratch == nullptr){
+            allocated.resize(an + bn + 1);
+            scratch = allocated.data();
+        }
+        limb * u = scratch;
+        limb * v = scratch + an + 1;
+        const limb norm = base / (b[bn - 1] + 1);
+        u[an] = mul_1(u, a, an, norm);
+        mul_1(v, b, bn, norm);
+        const limb vtop = v[bn - 1], vnext = v[bn - 2];
+        for (std::size_t j = an - bn + 1; j > 0; --j){
+            limb * uj = u + j - 1;
+            // estimate quotient limb from the top limbs:
+            dlimb top = static_cast<dlimb>(uj[bn]) * base + uj[bn - 1];
+            dlimb qhat = top / vtop;
+            dlimb rhat = top - qhat * vtop;
+            while (qhat >= base || qhat * vnext > rhat * base + uj[bn - 2]){
+                --qhat;
+                rhat += vtop;
+                if (rhat >= base) break;
             }
-            else if(tmp == "%"){
-                if(stack.size() < 2){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                a = std::move(stack.back()); stack.pop_back();
-                stack.back()%=a;
+            // multiply and subtract, add back if qhat was still one too large:
+            limb qj = static_cast<limb>(qhat);
+            limb borrow = submul_1(uj, v, bn, qj);
+            if (uj[bn] < borrow){
+                --qj;
+                limb carry = add_n(uj, uj, v, bn);
+                uj[bn] = uj[bn] + carry - borrow;
             }
-            else if(tmp == "@pow"){
-                if(stack.size() < 2){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                a = std::move(stack.back()); stack.pop_back();
-                stack.back().pow(a);
+            else{
+                uj[bn] -= borrow;
             }
-            else if(tmp == "@floor"){
-                if(stack.empty()){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                stack.back().floor();
+            q[j - 1] = qj;
+        }
+        // unnormalize the remainder:
+        divrem_1(r, u, bn, norm);
+    }
+
+    /**
+     * @brief r = a * b, schoolbook multiplication
+     *
+     * The result r must have room for an+bn limbs and must not alias
+     * either of the operands. Both an and bn must be nonzero.
+     */
+    static void mul_basecase(limb * r,
+                             const limb * a, std::size_t an,
+                             const limb * b, std::size_t bn){
+        r[an] = mul_1(r, a, an, b[0]);
+        for (std::size_t i = 1; i < bn; ++i){
+            r[an + i] = addmul_1(r + i, a, an, b[i]);
+        }
+    }
+
+    /**
+     * @brief r = a * a, schoolbook squaring
+     *
+     * Every product a[i]*a[j] with i < j is computed once and doubled,
+     * then the squares a[i]*a[i] are added in place, which takes about
+     * half of the limb multiplications of mul_basecase and no memory
+     * besides r. The result r must have room for 2n limbs and must not
+     * alias a. n must be nonzero.
+     */
+    static void sqr_basecase(limb * r, const limb * a, std::size_t n){
+        r[0] = 0;
+        r[2 * n - 1] = 0;
+        if (n > 1){
+            r[n] = mul_1(r + 1, a + 1, n - 1, a[0]);
+            for (std::size_t i = 1; i + 1 < n; ++i){
+                r[n + i] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
             }
-            else if(tmp == "@ceil"){
-                if(stack.empty()){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
-                }
-                stack.back().ceil();
+            add_n(r, r, r, 2 * n);
+        }
+        // limbs are below 2^63, so a limb, a square limb and a carry fit
+        limb carry = 0;
+        for (std::size_t i = 0; i < n; ++i){
+            limb low;
+            const limb high = divmod_base(static_cast<dlimb>(a[i]) * a[i], low);
+            limb tmp = r[2 * i] + low + carry;
+            carry = (tmp >= base);
+            r[2 * i] = carry ? tmp - base : tmp;
+            tmp = r[2 * i + 1] + high + carry;
+            carry = (tmp >= base);
+            r[2 * i + 1] = carry ? tmp - base : tmp;
+        }
+    }
+
+    /**
+     * @brief r = a + b, where a has length an and b has length bn <= an
+     * @return Carry out of the most significant limb (0 or 1)
+     */
+    static limb add(limb * r, const limb * a, std::size_t an, const limb * b, std::size_t bn){
+        return add_1(r + bn, a + bn, an - bn, add_n(r, a, b, bn));
+    }
+
+    /**
+     * @brief r = a - b, where a has length an and b has length bn <= an
+     * @return Borrow out of the most significant limb (0 or 1)
+     */
+    static limb sub(limb * r, const limb * a, std::size_t an, const limb * b, std::size_t bn){
+        return sub_1(r + bn, a + bn, an - bn, sub_n(r, a, b, bn));
+    }
+
+    /**
+     * @brief r = a * b, picks the multiplication algorithm by operand size
+     *
+     * The result r must have room for an+bn limbs and must not alias
+     * either of the operands. Both an and bn must be nonzero.
+     * Below FIXEDPOINT_KARATSUBA_THRESHOLD limbs schoolbook multiplication
+     * is used, then Karatsuba, from FIXEDPOINT_TOOM3_THRESHOLD limbs Toom-3
+     * and from FIXEDPOINT_NTT_THRESHOLD limbs number theoretic transform.
+     * Operands of very different lengths are multiplied in blocks.
+     * Passing the same operand twice selects the squaring variants.
+     */
+    static void mul(limb * r,
+                    const limb * a, std::size_t an,
+                    const limb * b, std::size_t bn){
+        if (an < bn){
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        if (bn < FIXEDPOINT_KARATSUBA_THRESHOLD){
+            if (a == b && an == bn) sqr_basecase(r, a, an);
+            else mul_basecase(r, a, an, b, bn);
+        }
+        else if (bn >= FIXEDPOINT_NTT_THRESHOLD && an + bn <= ntt_max_length){
+            mul_ntt(r, a, an, b, bn);
+        }
+        else if (2 * bn <= an + 1){
+            mul_unbalanced(r, a, an, b, bn);
+        }
+        else if (bn >= FIXEDPOINT_TOOM3_THRESHOLD && bn > 2 * ((an + 2) / 3)){
+            mul_toom3(r, a, an, b, bn);
+        }
+        else{
+            mul_karatsuba(r, a, an, b, bn);
+        }
+    }
+
+    /**
+     * @brief Removes most significant zero limbs
+     */
+    static void trim(limb_vector & x){
+        while (!x.empty() && x.back() == 0) x.pop_back();
+    }
+
+    /**
+     * @brief Compares two trimmed magnitudes
+     * @return 0 if equal, n<0 if a<b, n>0 if a>b
+     */
+    static int cmp_mag(const limb_vector & a, const limb_vector & b){
+        if (a.size() != b.size()) return (a.size() > b.size()) ? 1 : -1;
+        return cmp_n(a.data(), b.data(), a.size());
+    }
+
+    /**
+     * @brief a += b on magnitudes
+     */
+    static void add_mag(limb_vector & a, const limb_vector & b){
+        if (a.size() < b.size()) a.resize(b.size(), 0);
+        if (add(a.data(), a.data(), a.size(), b.data(), b.size()) != 0) a.push_back(1);
+    }
+
+    /**
+     * @brief a -= b on magnitudes, a must not be smaller than b
+     */
+    static void sub_mag(limb_vector & a, const limb_vector & b){
+        sub(a.data(), a.data(), a.size(), b.data(), b.size());
+        trim(a);
+    }
+
+    /**
+     * @brief Multiplies two magnitudes
+     * @return Trimmed product
+     */
+    static limb_vector mul_mag(const limb_vector & a, const limb_vector & b){
+        limb_vector product;
+        if (a.empty() || b.empty()) return product;
+        product.resize(a.size() + b.size());
+        mul(product.data(), a.data(), a.size(), b.data(), b.size());
+        trim(product);
+        return product;
+    }
+
+    /**
+     * @brief Squares a magnitude
+     * @return Trimmed square
+     */
+    static limb_vector sqr_mag(const limb_vector & a){
+        return mul_mag(a, a);
+    }
+
+    /**
+     * @brief Divides two magnitudes
+     *
+     * Uses long division unless both the divisor and the quotient have
+     * at least FIXEDPOINT_NEWTON_THRESHOLD limbs, then divides through
+     * a reciprocal computed by Newton iteration.
+     * @param a dividend
+     * @param b nonzero divisor
+     * @param q output for trimmed quotient
+     * @param r output for trimmed remainder
+     */
+    static void divrem_mag(const limb_vector & a,
+                           const limb_vector & b,
+                           limb_vector & q,
+                           limb_vector & r){
+        if (cmp_mag(a, b) < 0){
+            q.clear();
+            r = a;
+            return;
+        }
+        if (b.size() >= FIXEDPOINT_NEWTON_THRESHOLD &&
+                a.size() - b.size() >= FIXEDPOINT_NEWTON_THRESHOLD){
+            divrem_newton(a, b, q, r);
+            return;
+        }
+        q.assign(a.size() - b.size() + 1, 0);
+        r.assign(b.size(), 0);
+        divrem(q.data(), r.data(), a.data(), a.size(), b.data(), b.size());
+        trim(q);
+        trim(r);
+    }
+
+    /**
+     * @brief Calculates b^e as a magnitude, 2 <= b < base
+     *
+     * Multiplies the cached powers b^(chunk*2^i) selected by the bits of e/chunk.
+     */
+    static limb_vector pow_mag(limb b, std::size_t e){
+        limb unit;
+        const unsigned chunk = unit_chunk(b, unit);
+        limb_vector result(1, limb_pow(b, static_cast<unsigned>(e % chunk)));
+        const std::size_t q = e / chunk;
+        if (q != 0){
+            std::size_t count = 0;
+            while ((q >> count) != 0) ++count;
+            const power_cache::table powers = cached_powers(unit, count);
+            for (std::size_t i = 0; i < count; ++i){
+                if ((q >> i) & 1) result = mul_mag(result, *powers[i]);
             }
-            else if(tmp == "@trunc"){
-                if(stack.empty()){
-                    std::clog << "Not enough arguments for performing operation: " << tmp;
-                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+        }
+        return result;
+    }
+
+    template<typename It>
+    /**
+     * @brief Converts digit values of radix rdx to a magnitude
+     *
+     * Digit strings longer than FIXEDPOINT_CONVERSION_THRESHOLD limbs are
+     * split at powers rdx^(chunk*2^i), both halves are converted recursively
+     * and recombined by fast multiplication, so the conversion costs
+     * O(M(n) log n) instead of quadratic time. The powers are taken from
+     * and added to power_cache.
+     * @param d   random access iterator to digit values, most significant first
+     * @param n   number of digits
+     * @param rdx radix of the digits, 2 <= rdx < base
+     * @return Trimmed magnitude
+     */
+    static limb_vector from_digits(It d, std::size_t n, limb rdx){
+        // the base case packs chunk digits into a limb
+        limb unit;
+        const unsigned chunk = unit_chunk(rdx, unit);
+        // powers[i] = rdx^(chunk*2^i), as many as the splits of n digits need
+        power_cache::table powers;
+        if (n > chunk * std::size_t(FIXEDPOINT_CONVERSION_THRESHOLD)){
+            std::size_t count = 1;
+            while ((std::size_t(chunk) << count) < n) ++count;
+            powers = cached_powers(unit, count);
+        }
+        limb_vector result;
+        from_digits(result, d, n, rdx, chunk, powers);
+        trim(result);
+        return result;
+    }
+
+private:
+    /**
+     * @brief Largest chunk for which unit = rdx^chunk is smaller than base
+     */
+    static unsigned unit_chunk(limb rdx, limb & unit){
+        unsigned chunk = 1;
+        unit = rdx;
+        while (unit <= (base - 1) / rdx){
+            unit *= rdx;
+            ++chunk;
+        }
+        return chunk;
+    }
+
+    /**
+     * @brief Returns at least count powers unit^(2^i), through power_cache
+     */
+    static power_cache::table cached_powers(limb unit, std::size_t count){
+        power_cache::table powers = power_cache::instance().get(radix, unit);
+        if (powers.size() >= count) return powers;
+        if (powers.empty()) powers.push_back(std::make_shared<const limb_vector>(1, unit));
+        while (powers.size() < count){
+            powers.push_back(std::make_shared<const limb_vector>(sqr_mag(*powers.back())));
+        }
+        power_cache::instance().put(radix, unit, powers);
+        return powers;
+    }
+
+    template<typename It>
+    /**
+     * @brief Recursive step of from_digits, r = value of n digits at d
+     */
+    static void from_digits(limb_vector & r, It d, std::size_t n, limb rdx,
+                            unsigned chunk, const power_cache::table & powers){
+        if (n <= chunk * std::size_t(FIXEDPOINT_CONVERSION_THRESHOLD)){
+            r.clear();
+            r.reserve(n / chunk + 1);
+            // the leading group is shorter if n is not a multiple of chunk
+            std::size_t group = (n % chunk == 0) ? chunk : n % chunk;
+            for (std::size_t i = 0; i < n; i += group, group = chunk){
+                limb acc = 0, mult = 1;
+                for (std::size_t j = 0; j < group; ++j){
+                    acc = acc * rdx + static_cast<limb>(d[i + j]);
+                    mult *= rdx;
                 }
-                stack.back().trunc();
-            }
-            else if(tmp.front() == '@'){
-                throw(invalid_expression_format(("unsupported function token found: "s).append(tmp)));
-            }
-            else{ // is a number
-                stack.push_back(number(tmp));
+                limb carry = mul_1(r.data(), r.data(), r.size(), mult);
+                if (carry != 0) r.push_back(carry);
+                carry = add_1(r.data(), r.data(), r.size(), acc);
+                if (carry != 0) r.push_back(carry);
             }
+            return;
         }
-        if (stack.empty()) throw(invalid_expression_format("No result after evaluation, did you enter an empty string?"));
-        a = std::move(stack.back());
-        return a;
+        // the lower part gets the largest power of two number of chunks below n
+        std::size_t i = powers.size() - 1;
+        while ((std::size_t(chunk) << i) >= n) --i;
+        const std::size_t lown = std::size_t(chunk) << i;
+        limb_vector high, low;
+        from_digits(high, d, n - lown, rdx, chunk, powers);
+        from_digits(low, d + (n - lown), lown, rdx, chunk, powers);
+        r = mul_mag(high, *powers[i]);
+        add_mag(r, low);
     }
 
+    /**
+     * @brief Approximates base^2n / v by Newton iteration
+     *
+     * The divisor v has n limbs and must be normalized, its most
+     * significant limb at least base/2. Each step refines the reciprocal
+     * of the top n/2+1 limbs by x += x*(1 - v*x), doubling the number of
+     * correct limbs, so the whole costs a few n-limb multiplications.
+     * @return Trimmed reciprocal, within a few units of the exact value
+     */
+    static limb_vector reciprocal(const limb * v, std::size_t n){
+        if (n <= FIXEDPOINT_NEWTON_THRESHOLD){
+            limb_vector power(2 * n + 1, 0), x(n + 2), rem(n);
+            power[2 * n] = 1;
+            divrem(x.data(), rem.data(), power.data(), power.size(), v, n);
+            trim(x);
+            return x;
+        }
+        const std::size_t h = n / 2 + 1;
+        const limb_vector xh = reciprocal(v + n - h, h);
+        // error term e = base^(n+h) - v*xh, tiny compared to base^(n+h):
+        limb_vector vx(n + xh.size()), e(n + h + 1, 0);
+        mul(vx.data(), v, n, xh.data(), xh.size());
+        trim(vx);
+        e[n + h] = 1;
+        const bool negative = cmp_mag(e, vx) < 0;
+        if (negative) e.swap(vx);
+        sub_mag(e, vx);
+        // x = xh*base^(n-h) + xh*e/base^2h:
+        limb_vector correction = mul_mag(xh, e);
+        correction.erase(correction.begin(),
+                         correction.begin() + std::min(correction.size(), 2 * h));
+        limb_vector x(n - h, 0);
+        x.insert(x.end(), xh.begin(), xh.end());
+        if (negative) sub_mag(x, correction);
+        else add_mag(x, correction);
+        return x;
+    }
 
     /**
-     * @brief Evaluates an expression in infix notation
+     * @brief Divides two magnitudes by multiplying with the reciprocal of the divisor
      *
-     * Expression format rules:
-     * <ul>
-     *  <li>Tokens can not contain spaces, however, you can separate
-     * tokens with as many (including none) spaces</li>
-     *  <li>Parentheses, square brackets and braces are allowed to indicate precedence
-     * and denote function parameter list</li>
-     *  <li>If a function has more than one parameter, separate with ',' (comma)</li>
-     *  <li>Denote function names with a leading '@' char
-     * (in certain radices, the function name itself is a valid number)</li>
-     *  <li>Write numbers according to the format specified in string constructor's documentation,
-     * but only use the '.' (dot) character as radix point</li>
-     * </ul>
-     * @return Number containing the result of the evaluated expression
-     * @throw invalid_expression_format with details of error provided by what() and printed to cerr
-     * @throw whatever eval_postfix might throw
+     * Only as many top limbs of the divisor as the quotient has are used
+     * for the reciprocal. The estimated quotient is off by a few units at
+     * most and is corrected against the exact remainder.
      */
-    static number eval_infix(const std::string & expr){
-        using std::string; using namespace std::literals;
-        // xzauko number<16>::eval_infix("10::23 + 2::100010")
-        auto getToken = [
-                beg = expr.cbegin(),
-                end = expr.cend(),
-                separators = string("([{+*%/)]},")]
-                ( string & out,
-                  string::const_iterator & x)
-                -> bool
-        {
-            string token;
-            string::const_iterator prev = x-1;
-            while(x!=end && *x == ' ') ++x;
-            prev = x-1;
-            if( x != end ){
-                if (separators.find(*x)!=string::npos){
-                    // single character token
-                    token.push_back(*(prev = x++));
-                }
-                else if( (*x)=='-' ){
-                    if( (prev<beg) ||
-                        *prev=='-' ||
-                        *prev==' ' ||
-                        separators.find(*prev)!=string::npos ){
-                        token.push_back(*(prev = x++));
-                        while( x!=end &&
-                               (*x != '-' || *prev==':') &&
-                               *x != ' ' &&
-                               separators.find(*x)==string::npos){
-                            token.push_back(*(prev = x++));
+    static void divrem_newton(const limb_vector & a,
+                              const limb_vector & b,
+                              limb_vector & q,
+                              limb_vector & r){
+        const limb norm = base / (b.back() + 1);
+        const limb_vector one(1, 1);
+        limb_vector u(a.size() + 1), v(b.size());
+        u.back() = mul_1(u.data(), a.data(), a.size(), norm);
+        mul_1(v.data(), b.data(), b.size(), norm);
+        trim(u);
+        const std::size_t n = v.size();
+        // the quotient has at most u.size()-n+1 limbs, one more divisor limb suffices:
+        const std::size_t p = std::min(n, u.size() - n + 2);
+        const std::size_t dropped = n - p;
+        // the reciprocal must be at least half as long as the truncated dividend:
+        const std::size_t precision = std::max(p, u.size() - dropped - p);
+        limb_vector vt(precision - p, 0);
+        vt.insert(vt.end(), v.end() - p, v.end());
+        const limb_vector x = reciprocal(vt.data(), precision);
+        const limb_vector ut(u.begin() + dropped, u.end());
+        q = mul_mag(ut, x);
+        q.erase(q.begin(), q.begin() + std::min(q.size(), precision + p));
+        // correct the estimate:
+        limb_vector product = mul_mag(q, v);
+        while (cmp_mag(product, u) > 0){
+            sub_mag(product, v);
+            sub_mag(q, one);
+        }
+        r = u;
+        sub_mag(r, product);
+        while (cmp_mag(r, v) >= 0){
+            sub_mag(r, v);
+            add_mag(q, one);
+        }
+        // unnormalize the remainder:
+        if (!r.empty()) divrem_1(r.data(), r.data(), r.size(), norm);
+        trim(r);
+    }
+
+    /**
+     * @brief Magnitude with a sign, for intermediate values of Toom-3
+     */
+    struct signed_mag{
+        limb_vector mag;
+        bool negative;
+    };
+
+    /**
+     * @brief Calculates a + b, or a - b if subtract is set
+     */
+    static signed_mag signed_add(const signed_mag & a, const signed_mag & b, bool subtract){
+        signed_mag result{a.mag, a.negative};
+        bool bnegative = (b.negative != subtract);
+        if (a.negative == bnegative){
+            add_mag(result.mag, b.mag);
+        }
+        else if (cmp_mag(a.mag, b.mag) >= 0){
+            sub_mag(result.mag, b.mag);
+        }
+        else{
+            result.mag = b.mag;
+            sub_mag(result.mag, a.mag);
+            result.negative = bnegative;
+        }
+        if (result.mag.empty()) result.negative = false;
+        return result;
+    }
+
+    /**
+     * @brief Multiplies or divides (exactly) a signed magnitude by a single limb
+     */
+    static void signed_scale(signed_mag & x, limb mul, limb div){
+        if (mul != 1){
+            limb carry = mul_1(x.mag.data(), x.mag.data(), x.mag.size(), mul);
+            if (carry != 0) x.mag.push_back(carry);
+        }
+        if (div != 1){
+            divrem_1(x.mag.data(), x.mag.data(), x.mag.size(), div);
+            trim(x.mag);
+        }
+    }
+
+    /**
+     * @brief Adds a trimmed magnitude to r at a limb offset, the sum must fit into rn limbs
+     */
+    static void add_at(limb * r, std::size_t rn, std::size_t offset, const limb_vector & x){
+        if (!x.empty()) add(r + offset, r + offset, rn - offset, x.data(), x.size());
+    }
+
+    /**
+     * @brief Multiplies a by b in blocks of bn limbs, requires an >= bn
+     */
+    static void mul_unbalanced(limb * r,
+                               const limb * a, std::size_t an,
+                               const limb * b, std::size_t bn){
+        mul(r, a, bn, b, bn);
+        limb_vector tmp(2 * bn);
+        for (std::size_t i = bn; i < an; i += bn){
+            std::size_t len = std::min(bn, an - i);
+            mul(tmp.data(), b, bn, a + i, len);
+            std::fill(r + i + bn, r + i + bn + len, 0);
+            add_n(r + i, r + i, tmp.data(), bn + len);
+        }
+    }
+
+    /**
+     * @brief Karatsuba multiplication, requires an >= bn > (an+1)/2
+     *
+     * With a = a1*X + a0, b = b1*X + b0 the product is
+     * a1*b1*X^2 + ((a0+a1)*(b0+b1) - a0*b0 - a1*b1)*X + a0*b0.
+     * When squaring all three products are squares as well.
+     */
+    static void mul_karatsuba(limb * r,
+                              const limb * a, std::size_t an,
+                              const limb * b, std::size_t bn){
+        const std::size_t h = (an + 1) / 2;
+        const std::size_t rn = an + bn;
+        const bool square = (a == b && an == bn);
+        // a0*b0 and a1*b1 go straight to their places in r:
+        mul(r, a, h, b, h);
+        mul(r + 2 * h, a + h, an - h, b + h, bn - h);
+        limb_vector sa(h + 1), sb(square ? 0 : h + 1), middle(2 * h + 2);
+        sa[h] = add(sa.data(), a, h, a + h, an - h);
+        if (square){
+            mul(middle.data(), sa.data(), h + 1, sa.data(), h + 1);
+        }
+        else{
+            sb[h] = add(sb.data(), b, h, b + h, bn - h);
+            mul(middle.data(), sa.data(), h + 1, sb.data(), h + 1);
+        }
+        sub(middle.data(), middle.data(), middle.size(), r, 2 * h);
+        sub(middle.data(), middle.data(), middle.size(), r + 2 * h, rn - 2 * h);
+        trim(middle);
+        add_at(r, rn, h, middle);
+    }
+
+    /**
+     * @brief Multiplication by number theoretic transform, requires an+bn <= ntt_max_length
+     *
+     * The limbs are convolved modulo five primes, every coefficient
+     * of the convolution is reconstructed by Garner's algorithm and
+     * the carries are propagated in base-(radix^digits).
+     */
+    static void mul_ntt(limb * r,
+                        const limb * a, std::size_t an,
+                        const limb * b, std::size_t bn){
+        static const std::uint32_t primes[5] = {
+            ntt_prime0::modulus, ntt_prime1::modulus, ntt_prime2::modulus,
+            ntt_prime3::modulus, ntt_prime4::modulus
+        };
+        // inverse[i][j] = primes[j]^-1 modulo primes[i], for j < i
+        static const struct garner_table{
+            std::uint32_t inverse[5][5];
+            garner_table(){
+                for (unsigned i = 0; i < 5; ++i){
+                    for (unsigned j = 0; j < i; ++j){
+                        std::uint64_t x = 1, y = primes[j] % primes[i];
+                        for (std::uint32_t e = primes[i] - 2; e != 0; e >>= 1, y = y * y % primes[i]){
+                            if (e & 1) x = x * y % primes[i];
                         }
-                    }
-                    else{
-                        token.push_back(*(prev = x++));
+                        inverse[i][j] = static_cast<std::uint32_t>(x);
                     }
                 }
-                else{ // function token or number token
-                    while( x!=end &&
-                           (*x != '-' || *prev==':') &&
-                           *x != ' ' &&
-                           separators.find(*x)==string::npos){
-                        token.push_back(*(prev = x++));
+            }
+        } garner;
+
+        const std::size_t rn = an + bn;
+        std::size_t n = 1;
+        while (n < rn - 1) n <<= 1;
+        std::vector<std::uint32_t> residues(5 * n);
+        ntt_prime0::convolution(residues.data(), a, an, b, bn, n);
+        ntt_prime1::convolution(residues.data() + n, a, an, b, bn, n);
+        ntt_prime2::convolution(residues.data() + 2 * n, a, an, b, bn, n);
+        ntt_prime3::convolution(residues.data() + 3 * n, a, an, b, bn, n);
+        ntt_prime4::convolution(residues.data() + 4 * n, a, an, b, bn, n);
+
+        limb carry[4] = {0, 0, 0, 0};
+        for (std::size_t t = 0; t < rn; ++t){
+            limb coefficient[4] = {0, 0, 0, 0};
+            if (t < n){
+                // mixed radix digits of the coefficient:
+                std::uint64_t v[5];
+                for (unsigned i = 0; i < 5; ++i){
+                    std::uint64_t x = residues[i * n + t];
+                    for (unsigned j = 0; j < i; ++j){
+                        x = (x + primes[i] - v[j] % primes[i]) * garner.inverse[i][j] % primes[i];
                     }
+                    v[i] = x;
+                }
+                // coefficient = v0 + p0*(v1 + p1*(v2 + p2*(v3 + p3*v4)))
+                coefficient[0] = v[4];
+                for (unsigned i = 4; i > 0; --i){
+                    mul_1(coefficient, coefficient, 4, primes[i - 1]);
+                    add_1(coefficient, coefficient, 4, v[i - 1]);
                 }
             }
-            else prev=x;
-            out = std::move(token);
-            return prev!=end;
+            add_n(carry, carry, coefficient, 4);
+            r[t] = carry[0];
+            carry[0] = carry[1];
+            carry[1] = carry[2];
+            carry[2] = carry[3];
+            carry[3] = 0;
+        }
+    }
+
+    /**
+     * @brief Toom-3 multiplication, requires an >= bn > 2*ceil(an/3)
+     *
+     * Both operands are split into three parts, evaluated at 0, 1, -1, -2
+     * and infinity, multiplied pointwise and interpolated back using
+     * the sequence by M. Bodrato. When squaring the operand is evaluated
+     * once and the pointwise products are squares.
+     */
+    static void mul_toom3(limb * r,
+                          const limb * a, std::size_t an,
+                          const limb * b, std::size_t bn){
+        const std::size_t k = (an + 2) / 3;
+        const std::size_t rn = an + bn;
+        auto part = [k](const limb * x, std::size_t xn, std::size_t i){
+            signed_mag p{limb_vector(x + i * k, x + std::min(xn, (i + 1) * k)), false};
+            trim(p.mag);
+            return p;
         };
-        auto isOperator = [operators = string("+-*%/")](const string & x){
-            return operators.find(x)!=string::npos;
+        // values at 0, 1, -1, -2 and infinity:
+        auto evaluate = [&part](const limb * x, std::size_t xn){
+            const signed_mag x0 = part(x, xn, 0), x1 = part(x, xn, 1), x2 = part(x, xn, 2);
+            signed_mag t = signed_add(x0, x2, false);
+            std::array<signed_mag, 5> v{{x0, signed_add(t, x1, false), signed_add(t, x1, true), signed_mag(), x2}};
+            t = signed_add(v[2], x2, false);
+            signed_scale(t, 2, 1);
+            v[3] = signed_add(t, x0, true);
+            return v;
         };
-        auto lesserEqualPrecedence = [](const string & o1, const string & o2) -> bool{
-            switch(o2.front()){
-            case '+': case '-':
-                return (o1=="+" || o1=="-");
-            case '*': case '/': case '%':
-                return true;
-            }
-            return false;
+        auto product = [](const signed_mag & x, const signed_mag & y){
+            signed_mag p{mul_mag(x.mag, y.mag), x.negative != y.negative};
+            if (p.mag.empty()) p.negative = false;
+            return p;
         };
-        std::vector<string> operationStack, postfixBuild;
-        string postfix, lparen{'(','[','{'}, rparen{')',']','}'};
-        std::istringstream inp(expr);
-        //while(x!=expr.cend() && *x==' ') ++x; //skip spaces at front of string
-        auto x = expr.cbegin();
-        string now;
-        //while (x!=expr.cend()){
-        while( getToken(now,x) ){
-            //while(x!=expr.cend() && *x==' ') ++x; //skip spaces after expression
-            if(isOperator(now)){
-                while( (!operationStack.empty()) &&
-                       isOperator(operationStack.back()) &&
-                       lesserEqualPrecedence(now, operationStack.back())){
-                    postfixBuild.push_back(std::move(operationStack.back()));
-                    operationStack.pop_back();
-                }
-                operationStack.push_back(std::move(now));
-            }
-            else if(now.front() == '@'){
-                operationStack.push_back(std::move(now));
-            }
-            else if(lparen.find(now)!=string::npos){
-                operationStack.push_back("(");
-            }
-            else if(now == ","){
-                while( (!operationStack.empty()) &&
-                       operationStack.back()!="("){
-                    postfixBuild.push_back(std::move(operationStack.back()));
-                    operationStack.pop_back();
-                }
-                if (operationStack.empty()){
-                    std::cerr << "Misplaced function separator found in " << expr;
-                    throw(invalid_expression_format("misplaced function argument separator - ','"));
-                }
-            }
-            else if(rparen.find(now)!=string::npos){
-                while( (!operationStack.empty()) &&
-                       operationStack.back()!="("){
-                    postfixBuild.push_back(std::move(operationStack.back()));
-                    operationStack.pop_back();
-                }
-                if (operationStack.empty()){
-                    std::cerr << "Mismatched right parethesis " << expr;
-                    throw(invalid_expression_format("mismatched right parethesis found"));
-                }
-                operationStack.pop_back(); // remove the left parenthesis
-                if ( (!operationStack.empty()) &&
-                     operationStack.back().front() == '@'){ // function call
-                    postfixBuild.push_back(std::move(operationStack.back()));
-                    operationStack.pop_back();
-                }
+        const bool square = (a == b && an == bn);
+        const std::array<signed_mag, 5> va = evaluate(a, an);
+        std::array<signed_mag, 5> evaluated_b;
+        if (!square) evaluated_b = evaluate(b, bn);
+        const std::array<signed_mag, 5> & vb = square ? va : evaluated_b;
+
+        // pointwise multiplication:
+        const signed_mag r0 = product(va[0], vb[0]), rinf = product(va[4], vb[4]);
+        const signed_mag r1 = product(va[1], vb[1]), rm1 = product(va[2], vb[2]);
+        const signed_mag rm2 = product(va[3], vb[3]);
+
+        // interpolation:
+        signed_mag t3 = signed_add(rm2, r1, true);
+        signed_scale(t3, 1, 3);
+        signed_mag t1 = signed_add(r1, rm1, true);
+        signed_scale(t1, 1, 2);
+        signed_mag t2 = signed_add(rm1, r0, true);
+        t3 = signed_add(t2, t3, true);
+        signed_scale(t3, 1, 2);
+        signed_mag twice_inf = rinf;
+        signed_scale(twice_inf, 2, 1);
+        t3 = signed_add(t3, twice_inf, false);
+        t2 = signed_add(signed_add(t2, t1, false), rinf, true);
+        t1 = signed_add(t1, t3, true);
+
+        // recomposition, all of t1, t2, t3 are nonnegative here:
+        std::fill(r, r + rn, 0);
+        std::copy(r0.mag.begin(), r0.mag.end(), r);
+        std::copy(rinf.mag.begin(), rinf.mag.end(), r + 4 * k);
+        add_at(r, rn, k, t1.mag);
+        add_at(r, rn, 2 * k, t2.mag);
+        add_at(r, rn, 3 * k, t3.mag);
+    }
+};
+
+template<unsigned char radix>
+constexpr unsigned limb_arith<radix>::digits;
+template<unsigned char radix>
+constexpr limb limb_arith<radix>::base;
+template<unsigned char radix>
+constexpr unsigned limb_arith<radix>::norm_shift;
+template<unsigned char radix>
+constexpr limb limb_arith<radix>::base_inv;
+
+} // namespace detail
+
+/**
+ * @brief Sets the memory budget of cached radix powers
+ *
+ * Conversions of long numbers between radices cache the powers of the
+ * source radix they split at, shared by all threads and all number types.
+ * Tables that would exceed the budget are computed but not cached,
+ * lowering the budget below the current usage drops all tables.
+ * The default is FIXEDPOINT_POWER_CACHE_LIMIT, 0 disables caching.
+ * @param bytes budget for the limbs of all cached powers
+ */
+inline void set_power_cache_limit(std::size_t bytes){
+    detail::power_cache::instance().set_limit(bytes);
+}
+
+/**
+ * @brief Returns the memory budget of cached radix powers in bytes
+ */
+inline std::size_t power_cache_limit(){
+    return detail::power_cache::instance().limit();
+}
+
+/**
+ * @brief Returns the memory used by cached radix powers in bytes
+ */
+inline std::size_t power_cache_usage(){
+    return detail::power_cache::instance().usage();
+}
+
+/**
+ * @brief Drops all cached radix powers
+ */
+inline void clear_power_cache(){
+    detail::power_cache::instance().clear();
+}
+
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+struct fixed_number;
+
+template<unsigned char radix>
+/**
+ * <b>The number struct represents the fixedpoint numbers</b>
+ * <p>
+ * Before using any functions provided by this library,
+ * you must initialize its static member scale, you may use this code snippet:
+ * @code
+ * template<unsigned char radix>
+ * std::size_t number<radix>::scale = 0;
+ * @endcode
+ * <p>
+ * You can parametrise the numeral system used by template parameter.
+ * The default numeral system is base-10, to set base-n numeral system
+ * instantiate the template with n*.
+ * <p>
+ * You can select numeral interpretation strategy in strings
+ * by defining a macro:
+ * <ul>
+ *  <li>FIXEDPOINT_CASE_INSENSITIVE for case insensitive interpretation</li>
+ *  <li>FIXEDPOINT_CASE_SENSITIVE for case sensitive interpretation</li>
+ * </ul>
+ * The default is case insensitive interpretation.
+ * The numerals take the following precedence, from lowest to highest value:
+ * <ul>
+ *  <li>numbers from 0 to 9</li>
+ *  <li>letters 'a' to 'z' (lowercase) in alphabetical order</li>
+ *  <li>letters 'A' to 'Z' (uppercase) in alphabetical order</li>
+ *  <li>characters '#'(valued as 62 decimal) and '$'(valued as 63 decimal)</li>
+ * </ul>
+ * The lowercase letters are preferred for string representation in case
+ * insensitive mode. Characters '#' and '$' are invalid for case insensitive
+ * mode.
+ * <p>
+ * Multiplication switches from schoolbook to Karatsuba, Toom-3 and
+ * number theoretic transform algorithms as the operands grow. The switch
+ * points (in limbs of the shorter operand) can be tuned by defining the macros
+ * FIXEDPOINT_KARATSUBA_THRESHOLD, FIXEDPOINT_TOOM3_THRESHOLD and
+ * FIXEDPOINT_NTT_THRESHOLD before including this header.
+ * Division uses long division, or Newton iteration for the reciprocal of
+ * the divisor once both the divisor and the quotient reach
+ * FIXEDPOINT_NEWTON_THRESHOLD limbs.
+ * <p>
+ * Digit strings are validated and packed into limbs with SSE4.2 or AVX2
+ * instructions when the compiler targets them (e.g. -msse4.2 or -mavx2),
+ * defining FIXEDPOINT_NO_SIMD restricts parsing to portable code.
+ * <p>
+ * Internally the value is kept as an unsigned magnitude scaled by
+ * radix^(number of fractional digits), packed into 64-bit limbs each holding
+ * as many base-radix digits as fit (see detail::limb_arith). Digit characters
+ * only appear when converting from and to strings. Magnitudes of up to two
+ * limbs are stored inline without heap allocation (see detail::limb_vector),
+ * and addition, subtraction and multiplication of single limb values run in
+ * native 128-bit integers.
+ * <p>
+ * <p>
+ * Notes:
+ * <p>
+ * <ol>
+ * <li>implementation caveat - maximum supported system is base-36 (or base-64),
+ * due to lack of suitable ASCII chaacters to express numerals</li>
+ * </ol>
+ */
+struct number{
+
+    /**
+     * @brief To what number of fractional places to perform division.
+     *
+     * Affects modulo as well - mudulo is performed to
+     * scale+number of fractional digits of the divisor precision.
+     * This is the process wide default, a scale_guard overrides it
+     * for a single thread.
+     */
+    static std::size_t scale;
+
+    /**
+     * @brief Sets the scale of the current thread while in scope
+     *
+     * Division, modulo, pow() and the expression evaluators use the value
+     * of the innermost guard alive on the calling thread instead of the
+     * shared static scale, so threads don't need to synchronize when they
+     * compute with different precision. Guards must be destroyed in the
+     * reverse order of construction, which scoping does naturally.
+     * @code
+     * {
+     *     decimal::scale_guard precision(50);
+     *     decimal third = decimal(1) / decimal(3); // 50 fractional digits
+     * }
+     * @endcode
+     */
+    struct scale_guard{
+        /**
+         * @brief Activates the guard
+         * @param value scale to use on this thread
+         */
+        explicit scale_guard(std::size_t value):
+            value(value),
+            previous(active_guard())
+        {
+            active_guard() = this;
+        }
+        ~scale_guard(){
+            active_guard() = previous;
+        }
+        scale_guard(const scale_guard &) = delete;
+        scale_guard & operator =(const scale_guard &) = delete;
+
+        /**
+         * @brief Scale in effect while this guard is the innermost one
+         */
+        const std::size_t value;
+    private:
+        scale_guard * previous;
+    };
+
+    /**
+     * @brief Scale in effect on the calling thread
+     * @return Value of the innermost scale_guard of this thread, scale if there is none
+     */
+    static std::size_t current_scale(){
+        const scale_guard * guard = active_guard();
+        return guard ? guard->value : scale;
+    }
+
+    /**
+     * @brief Default constructor
+     *
+     * Constructs a number of zero value and zero scale.
+     */
+    number():
+        limbs{},
+        frac_digits(0),
+        isPositive(true)
+    {
+        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
+        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
+    }
+    /**
+     * @brief String constructor
+     *
+     * Key for source string format:
+     * <ul>
+     *  <li>s       First position for - sign (optional)</li>
+     *  <li>RR      Decimal digits of radix (optional, always couple with radix separator)</li>
+     *  <li>::      Radix separator (optional, always must be coupled with radix)</li>
+     *  <li>S       Second position for - sign (optional)</li>
+     *  <li>D...D   Digits of the whole part</li>
+     *  <li>p       Radix point - '.' or ',' character (optional, always couple with fractional part)</li>
+     *  <li>d...d   Digits of the fractional part (optional, always precede by radix point)</li>
+     * </li>
+     *
+     * If you don't specify fracnum, by default the size of the detected
+     * fractional part is taken and multiplied by ceil of source_radix/target_radix
+     * and the result of that operation is considered as fracnum (aka IMPLICIT STRATEGY).
+     *
+     * If you specify fracnum as a nonnegative integer that number is not modified
+     * in any way and fractional part is calculated to that size.
+     *
+     * If you specify fracnum as a negative integer, the implicit strategy is performed.
+     *
+     * Regardless of what is the value of fracnum, the resulting number is always
+     * stripped of leading and trailing zeroes.
+     *
+     * @param src   source string according to format sRR::SD...Dpd...d
+     * @param fracnum how many fractional digits to store after conversion
+     * @throw invalid_number_format upon misformatted number, further details in what() and cerr
+     * @throw radix_invalid when radix is specified incorrectly or is not supported
+     */
+    explicit number(const std::string & src, long long int fracnum = -1):
+        frac_digits(0),
+        isPositive(src.find_first_of('-')==src.npos)
+    {
+        using namespace std::literals;
+        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
+        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
+        // too many decimal separators are reported before any other error:
+        auto check_separators = [&src](){
+            if (std::count_if(
+                        src.cbegin(),
+                        src.cend(),
+                        [](const char c){return static_cast<unsigned char>(c) < 128 && values[static_cast<int>(c)]==-2;}
+                        ) > 1){
+                std::cerr << src
+                          << " contains too many decimal separators"
+                          << std::flush;
+                throw(invalid_number_format("contains more than one decimal separator"));
+            }
+        };
+        auto start = src.cbegin();
+        std::size_t rdx = radix;
+        if (*start=='-') ++start; // negative check already happened
+        if ((src.find_first_of(':'))!=src.npos){ // has radix specified
+            std::stringstream x("");
+            while(*start != ':'){
+                if(*start<'0' || '9'<*start) {
+                    check_separators();
+                    std::cerr << src
+                              << " contains invalid characters in radix"
+                              << std::flush;
+                    throw(invalid_number_format("src's radix is ill formatted"));
+                }
+                x << *start;
+                ++start;
+            }
+            x >> rdx; // radix is always specified as decimal number
+            if ( rdx > MAX_RADIX || rdx < 2 ) {
+                check_separators();
+                throw(radix_invalid());
+            }
+            ++start; // goes to second colon
+            if (*start != ':'){
+                check_separators();
+                std::cerr << src
+                          << " is missing a colon in radix separator"
+                          << std::flush;
+                throw(invalid_number_format("missing 2nd colon in separator"));
+            }
+            ++start;
+        }
+        if ((!isPositive) && *start=='-'){
+            // - sign was not read yet
+            ++start;
+        }
+        // get digit values of whole and decimal parts, validating them on the way:
+        const char * const first = src.data() + (start - src.cbegin());
+        const char * const end = src.data() + src.size();
+        std::string digit_values;
+        digit_values.reserve(end - first);
+        std::size_t whole_count;
+        if (read_digits(first, end, rdx, digit_values, whole_count) != end){
+            check_separators();
+            std::cerr << src
+                      << " contains invalid characters for radix "
+                      << rdx
+                      << std::flush;
+            throw(invalid_number_format("invalid characters found in input string"));
+        }
+        // convert here:
+        if (rdx == radix){
+            // only need to pack the digits and maybe resize decimal
+            if (fracnum >= 0) digit_values.resize(whole_count + fracnum, 0);
+            assign_digits(reinterpret_cast<const unsigned char *>(digit_values.data()),
+                          digit_values.size(), digit_values.size() - whole_count);
+        }
+        else{
+            // convert from base rdx to base radix,
+            // the whole part is stored least significant digit first:
+            std::string whole(digit_values.crend() - whole_count, digit_values.crend());
+            std::string decimal(digit_values, whole_count);
+            if (fracnum < 0) fracnum = std::ceil(static_cast<double>(rdx)/radix)*decimal.size();
+            if (detail::radix_root(rdx) == regrouper::root) assign_regrouped(whole, decimal, rdx, fracnum);
+            else assign_converted(whole, decimal, rdx, fracnum);
+        }
+    }
+
+    /**
+     * @brief Integral type constructor
+     * @param x value to construct number with
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+    number(T x):
+        limbs{},
+        frac_digits(0),
+        isPositive(x>=0)
+    {
+        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
+        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
+        // magnitude, computed in unsigned arithmetic so that minimal values don't overflow
+        unsigned long long mag = static_cast<unsigned long long>(x);
+        if (!isPositive) mag = 0ull - mag;
+        while (mag != 0){
+            limbs.push_back(mag % arith::base);
+            mag /= arith::base;
+        }
+    }
+
+    /**
+     * @brief Floating point type constructor
+     *
+     * Decodes the binary mantissa and exponent of x and converts them
+     * without going through decimal strings, so the result is x rounded
+     * to fracnum fractional digits (to nearest, ties to even) in any radix.
+     *
+     * If you specify fracnum as a negative integer, the value of x is kept
+     * exactly. Binary fractions do not terminate in odd radices, there x is
+     * rounded to one more fractional digit than its type has fractional bits,
+     * which is enough to get x back when converting to the type.
+     *
+     * The resulting number is stripped of trailing zeroes.
+     * @param x value to construct number with, must be finite
+     * @param fracnum how many fractional places to calculate (in target radix)
+     * @throw unsupported_operation if x is infinite or NaN
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_floating_point<T>()))>
+    explicit number(T x, long long int fracnum = 5):
+        frac_digits(0),
+        isPositive(!std::signbit(x))
+    {
+        static_assert(radix<=MAX_RADIX, "fixedpoint::number's radix too high");
+        static_assert(radix>=2, "fixedpoint::number's radix is too low, use at least 2");
+        static_assert(std::numeric_limits<T>::radix == 2 && std::numeric_limits<T>::digits <= 113,
+                      "fixedpoint::number supports binary floating point types with mantissas up to 113 bits");
+        if (!std::isfinite(x)){
+            throw(unsupported_operation("infinity and NaN cannot be represented"));
+        }
+        // x = mantissa * 2^exponent with an integral mantissa:
+        int exponent;
+        const T fraction = std::frexp(std::fabs(x), &exponent);
+        const int bits = std::numeric_limits<T>::digits;
+        assign_binary(static_cast<detail::dlimb>(std::ldexp(fraction, bits)), exponent - bits, fracnum);
+    }
+
+    number(const number &) = default;
+    number(number &&) = default;
+    number& operator =(const number &) = default;
+    number& operator =(number &&) = default;
+
+    // O(n) where n is number of limbs in number
+    number& operator +=(const number & other){
+        if ( add_small(other, false) ) return *this;
+        if ( isPositive != other.isPositive ){
+            isPositive = ! isPositive; // make the signs match
+            operator-=(other); // do -this-other
+            isPositive = ! isPositive;
+            // flip the resulting sign so that the result is correct
+        }
+        else if ( other.frac_digits > frac_digits ){
+            // extend our scale, other is added as is
+            scale_up(limbs, other.frac_digits - frac_digits);
+            frac_digits = other.frac_digits;
+            arith::add_mag(limbs, other.limbs);
+        }
+        else if ( other.frac_digits < frac_digits ){
+            // 1 copy to extend the scale of other
+            limb_vector o1(other.limbs);
+            scale_up(o1, frac_digits - other.frac_digits);
+            arith::add_mag(limbs, o1);
+        }
+        else{
+            arith::add_mag(limbs, other.limbs);
+        }
+        // At worst 1 copy (extending the scale)
+        // or whatever -= does
+        strip_zeroes();
+        return *this;
+    }
+
+    number & operator -=(const number &other){
+        if ( add_small(other, true) ) return *this;
+        if ( isPositive != other.isPositive ){
+            isPositive = ! isPositive; // make the signs match
+            operator+=(other); // do -this+other
+            isPositive = ! isPositive;
+            strip_zeroes();
+            return *this;
+        }
+        // at worst 1 copy to extend the scale of other
+        limb_vector o1;
+        const limb_vector * subtrahend = &other.limbs;
+        if ( other.frac_digits > frac_digits ){
+            scale_up(limbs, other.frac_digits - frac_digits);
+            frac_digits = other.frac_digits;
+        }
+        else if ( other.frac_digits < frac_digits ){
+            o1 = other.limbs;
+            scale_up(o1, frac_digits - other.frac_digits);
+            subtrahend = &o1;
+        }
+        if ( arith::cmp_mag(limbs, *subtrahend) < 0 ){
+            // subtracting larger (in absolute value) from smaller, swap them
+            limb_vector tmp(*subtrahend);
+            arith::sub_mag(tmp, limbs);
+            limbs.swap(tmp);
+            isPositive = !isPositive;
+        }
+        else{
+            arith::sub_mag(limbs, *subtrahend);
+        }
+        strip_zeroes();
+        // At worst 2 copies
+        // or whatever += does
+        return *this;
+    }
+
+    number & operator *=(const number & other){
+        // handle sign:
+        isPositive = (isPositive == other.isPositive);
+        if ( limbs.empty() || other.limbs.empty() ){
+            // trivial case - one of the numbers is 0
+            limbs.clear();
+        }
+        else if ( limbs.size() == 1 && other.limbs.size() == 1 &&
+                  std::min(frac_digits, other.frac_digits) < arith::digits ){
+            // single limbs, multiply and truncate in native integers
+            const std::size_t dropped = std::min(frac_digits, other.frac_digits);
+            dlimb product = static_cast<dlimb>(limbs[0]) * other.limbs[0];
+            product = arith::div_pow(product, static_cast<unsigned>(dropped));
+            limbs.clear();
+            limb low, high = arith::divmod_base(product, low);
+            limbs.push_back(low);
+            if (high != 0) limbs.push_back(high);
+            frac_digits = std::max(frac_digits, other.frac_digits);
+        }
+        else{
+            // both numbers are viewed as fractions limbs/radix^frac_digits,
+            // the product is truncated to the larger of the two scales
+            std::size_t endfrac = std::max(frac_digits, other.frac_digits);
+            limb_vector product = (&other == this) ? arith::sqr_mag(limbs)
+                                                         : arith::mul_mag(limbs, other.limbs);
+            scale_down(product, frac_digits + other.frac_digits - endfrac);
+            limbs.swap(product);
+            frac_digits = endfrac;
+        }
+        strip_zeroes();
+        return *this;
+    }
+
+    /**
+     * @brief Divides number
+     * @param other divisor
+     * @return Reference to *this
+     * @throw division_by_zero if divisor is zero
+     */
+    number & operator /=(const number &other){
+        // signs are handled in div_or_mod
+        div_or_mod(other,true);
+        strip_zeroes();
+        return *this;
+    }
+
+    /**
+     * @brief Computes modulo of number
+     * @param other divisor
+     * @return Reference to *this
+     * @throw division_by_zero if divisor is zero
+     */
+    number & operator %=(const number &other){
+        // modulo has the sign of first operand
+        div_or_mod(other,false);
+        strip_zeroes();
+        return *this;
+
+    }
+
+    /**
+     * @brief Adds an integral value without constructing a temporary number
+     * @param x value to add
+     * @return Reference to *this
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+    number & operator +=(T x){
+        limb mag;
+        if (!native_limb(x, mag)) return operator+=(number(x));
+        add_native(mag, x >= 0);
+        return *this;
+    }
+
+    /**
+     * @brief Subtracts an integral value without constructing a temporary number
+     * @param x value to subtract
+     * @return Reference to *this
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+    number & operator -=(T x){
+        limb mag;
+        if (!native_limb(x, mag)) return operator-=(number(x));
+        add_native(mag, !(x >= 0));
+        return *this;
+    }
+
+    /**
+     * @brief Multiplies by an integral value in place
+     * @param x multiplier
+     * @return Reference to *this
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+    number & operator *=(T x){
+        limb mag;
+        if (!native_limb(x, mag)) return operator*=(number(x));
+        isPositive = (isPositive == (x >= 0));
+        limb carry = arith::mul_1(limbs.data(), limbs.data(), limbs.size(), mag);
+        if (carry != 0) limbs.push_back(carry);
+        strip_zeroes();
+        return *this;
+    }
+
+    /**
+     * @brief Divides by an integral value in place
+     *
+     * The quotient is truncated to current_scale() fractional digits, as
+     * with division by a number.
+     * @param x divisor
+     * @return Reference to *this
+     * @throw division_by_zero if divisor is zero
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+    number & operator /=(T x){
+        limb mag;
+        if (!native_limb(x, mag)) return operator/=(number(x));
+        if (mag == 0) throw division_by_zero();
+        const std::size_t precision = current_scale();
+        if (precision >= frac_digits) scale_up(limbs, precision - frac_digits);
+        else scale_down(limbs, frac_digits - precision);
+        frac_digits = precision;
+        arith::divrem_1(limbs.data(), limbs.data(), limbs.size(), mag);
+        isPositive = (isPositive == (x >= 0));
+        strip_zeroes();
+        return *this;
+    }
+
+    /**
+     * @brief Computes modulo by an integral value in place
+     * @param x divisor
+     * @return Reference to *this
+     * @throw division_by_zero if divisor is zero
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+    number & operator %=(T x){
+        limb mag;
+        if (!native_limb(x, mag)) return operator%=(number(x));
+        if (mag == 0) throw division_by_zero();
+        // same as div_or_mod with a divisor without fractional digits:
+        const std::size_t precision = current_scale();
+        const std::size_t endfrac = std::max(frac_digits, precision);
+        scale_up(limbs, endfrac - frac_digits);
+        frac_digits = endfrac;
+        if (endfrac == precision){
+            limbs.assign(1, arith::mod_1(limbs.data(), limbs.size(), mag));
+        }
+        else{
+            // subtract the multiple of mag*radix^(endfrac-precision) that the quotient stands for
+            limb_vector multiple(limbs);
+            scale_down(multiple, endfrac - precision);
+            arith::divrem_1(multiple.data(), multiple.data(), multiple.size(), mag);
+            arith::trim(multiple);
+            limb carry = arith::mul_1(multiple.data(), multiple.data(), multiple.size(), mag);
+            if (carry != 0) multiple.push_back(carry);
+            scale_up(multiple, endfrac - precision);
+            arith::sub_mag(limbs, multiple);
+        }
+        strip_zeroes();
+        return *this;
+    }
+
+    number& operator ++(){
+        add_native(1, true);
+        return *this;
+    }
+    number& operator --(){
+        add_native(1, false);
+        return *this;
+    }
+    number operator ++(int){
+        number copy(*this);
+        operator++();
+        return copy;
+    }
+    number operator --(int){
+        number copy(*this);
+        operator--();
+        return copy;
+    }
+
+    bool operator <(const number & rhs) const{
+        if (rhs.isPositive && !isPositive) return true;
+        if (isPositive && ! rhs.isPositive) return false;
+        if (isPositive) return cmp_ignore_sig(rhs)<0;
+        return cmp_ignore_sig(rhs)>0;
+    }
+
+    bool operator ==(const number & rhs) const{
+        bool tmpResult = ( isPositive == rhs.isPositive);
+        if ( tmpResult ){
+            return cmp_ignore_sig(rhs) == 0;
+        }
+        return tmpResult;
+    }
+
+    /**
+     * @brief Calculates exponent-th power of number
+     * @param exponent  which power to calculate
+     * @return Reference to *this
+     * @throw unsupported_operation when attemted to power with fractional number
+     */
+    number& pow(const number & exponent){
+        // kontrola desatinnej casti:
+        if(exponent.frac_digits != 0){
+            throw unsupported_operation("Only integer exponent is suported for power function!");
+        }
+        // fast path for exponent 0
+        if(exponent.cmp_ignore_sig(number()) == 0){
+            operator=(number(1));
+        }
+        // fast path for powerbases 0 and (-)1
+        else if(cmp_ignore_sig(number())==0 || cmp_ignore_sig(number(1))==0){
+            if (! isPositive) { // 0 is treated as positive, therefore must be -1
+                isPositive = (arith::mod_1(exponent.limbs.data(), exponent.limbs.size(), 2) == 0);
+            }
+        }
+        else{
+            //vyřeším záporný exponent
+            if(!exponent.isPositive){
+                // convert the problem to positive power of inverse number
+                (*this) = number(1)/(*this);
+            }
+            // divide and conquer - halve the magnitude of the exponent in each pass,
+            // the integer halving needs no division scale
+            limb_vector expMag(exponent.limbs);
+            number others(1);
+            while(expMag.size() > 1 || expMag[0] > 1){
+                if(arith::divrem_1(expMag.data(), expMag.data(), expMag.size(), 2) != 0){
+                    others *= (*this);
+                }
+                arith::trim(expMag);
+                operator*=(*this);
+            }
+            operator*=(others);
+        }
+        strip_zeroes();
+        return *this;
+    }
+
+    /**
+     * @brief Floors the number
+     * @return Reference to *this
+     */
+    number& floor(){
+        if( frac_digits != 0 ){
+            if (! isPositive){
+                operator--();
+            }
+        }
+        return trunc();
+    }
+
+    /**
+     * @brief Ceils the number
+     * @return Reference to *this
+     */
+    number& ceil(){
+        if( frac_digits != 0 ){
+            if (isPositive){
+                operator++();
+            }
+        }
+        return trunc();
+    }
+
+    /**
+     * @brief Truncates the number
+     * @return Reference to *this
+     */
+    number& trunc(){
+        scale_down(limbs, frac_digits);
+        frac_digits = 0;
+        strip_zeroes();
+        return *this;
+    }
+
+    /**
+     * @brief Returns string representation of the object
+     * @return  A newly constructed string
+     */
+    std::string str() const{
+        std::string result;
+        append_to(result);
+        return result;
+    }
+
+    /**
+     * @brief Appends the string representation to out
+     *
+     * Writes the same characters as str() directly into out,
+     * growing it at most once.
+     * @return Reference to out
+     */
+    std::string & append_to(std::string & out) const{
+        const std::size_t total = digit_total();
+        const std::size_t size = out.size();
+        out.resize(size + str_length(total));
+        write_str(&out[size], total);
+        return out;
+    }
+
+    /**
+     * @brief Number of characters of the string representation
+     *
+     * This is the buffer size to_chars needs to format the number.
+     */
+    std::size_t str_length() const{
+        return str_length(digit_total());
+    }
+
+    /**
+     * @brief Number of bytes serialize writes for the number
+     */
+    std::size_t serialized_size() const{
+        if (limbs.empty()) return 4;
+        return 2 + detail::varint_size(frac_digits << 1) + detail::varint_size(limbs.size()) +
+                (limbs.size() - 1) * sizeof(limb) + detail::varint_size(limbs.back());
+    }
+
+    /**
+     * @brief Evaluates an expression in postfix (reverse polish) notation
+     *
+     * Expression format rules:
+     * <ul>
+     *  <li>Separate tokens (functions, numbers, operators) by space</li>
+     *  <li>Denote function names with a leading '@' char
+     * (in certain radices, the function name itself is a valid number)</li>
+     *  <li>Write numbers according to the format specified in string constructor's documentation</li>
+     * </ul>
+     * @return Number containing the result of the evaluated expression
+     * @throw invalid_expression_format with details of error provided by what() and printed to cerr
+     * @throw (whatever the string constructor might throw)
+     * @throw (whatever the functions or operations performed might throw)
+     */
+    static number eval_postfix(const std::string & expr){
+        using namespace std::literals;
+        std::vector<number> stack;
+        std::istringstream tokenizer(expr);
+        std::string tmp{};
+        number a;
+        std::string::const_iterator y;
+        while( tokenizer >> tmp ){
+            if( tmp.back() == '(') tmp.pop_back();
+            if(tmp == "+"){
+                if(stack.size() < 2){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                a = std::move(stack.back()); stack.pop_back();
+                stack.back()+=a;
+            }
+            else if(tmp == "-"){
+                if(stack.size() < 2){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                a = std::move(stack.back()); stack.pop_back();
+                stack.back()-=a;
+            }
+            else if(tmp == "*"){
+                if(stack.size() < 2){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                a = std::move(stack.back()); stack.pop_back();
+                stack.back()*=a;
+            }
+            else if(tmp == "/"){
+                if(stack.size() < 2){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                a = std::move(stack.back()); stack.pop_back();
+                stack.back()/=a;
+            }
+            else if(tmp == "%"){
+                if(stack.size() < 2){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                a = std::move(stack.back()); stack.pop_back();
+                stack.back()%=a;
+            }
+            else if(tmp == "@pow"){
+                if(stack.size() < 2){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                a = std::move(stack.back()); stack.pop_back();
+                stack.back().pow(a);
+            }
+            else if(tmp == "@floor"){
+                if(stack.empty()){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                stack.back().floor();
+            }
+            else if(tmp == "@ceil"){
+                if(stack.empty()){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                stack.back().ceil();
+            }
+            else if(tmp == "@trunc"){
+                if(stack.empty()){
+                    std::clog << "Not enough arguments for performing operation: " << tmp;
+                    throw(invalid_expression_format("requested operation needs more parameters than available"));
+                }
+                stack.back().trunc();
+            }
+            else if(tmp.front() == '@'){
+                throw(invalid_expression_format(("unsupported function token found: "s).append(tmp)));
+            }
+            else{ // is a number
+                stack.push_back(number(tmp));
+            }
+        }
+        if (stack.empty()) throw(invalid_expression_format("No result after evaluation, did you enter an empty string?"));
+        a = std::move(stack.back());
+        return a;
+    }
+
+
+    /**
+     * @brief Evaluates an expression in infix notation
+     *
+     * Expression format rules:
+     * <ul>
+     *  <li>Tokens can not contain spaces, however, you can separate
+     * tokens with as many (including none) spaces</li>
+     *  <li>Parentheses, square brackets and braces are allowed to indicate precedence
+     * and denote function parameter list</li>
+     *  <li>If a function has more than one parameter, separate with ',' (comma)</li>
+     *  <li>Denote function names with a leading '@' char
+     * (in certain radices, the function name itself is a valid number)</li>
+     *  <li>Write numbers according to the format specified in string constructor's documentation,
+     * but only use the '.' (dot) character as radix point</li>
+     * </ul>
+     * @return Number containing the result of the evaluated expression
+     * @throw invalid_expression_format with details of error provided by what() and printed to cerr
+     * @throw whatever eval_postfix might throw
+     */
+    static number eval_infix(const std::string & expr){
+        using std::string; using namespace std::literals;
+        // xzauko number<16>::eval_infix("10::23 + 2::100010")
+        auto getToken = [
+                beg = expr.cbegin(),
+                end = expr.cend(),
+                separators = string("([{+*%/)]},")]
+                ( string & out,
+                  string::const_iterator & x)
+                -> bool
+        {
+            string token;
+            string::const_iterator prev = x-1;
+            while(x!=end && *x == ' ') ++x;
+            prev = x-1;
+            if( x != end ){
+                if (separators.find(*x)!=string::npos){
+                    // single character token
+                    token.push_back(*(prev = x++));
+                }
+                else if( (*x)=='-' ){
+                    if( (prev<beg) ||
+                        *prev=='-' ||
+                        *prev==' ' ||
+                        separators.find(*prev)!=string::npos ){
+                        token.push_back(*(prev = x++));
+                        while( x!=end &&
+                               (*x != '-' || *prev==':') &&
+                               *x != ' ' &&
+                               separators.find(*x)==string::npos){
+                            token.push_back(*(prev = x++));
+                        }
+                    }
+                    else{
+                        token.push_back(*(prev = x++));
+                    }
+                }
+                else{ // function token or number token
+                    while( x!=end &&
+                           (*x != '-' || *prev==':') &&
+                           *x != ' ' &&
+                           separators.find(*x)==string::npos){
+                        token.push_back(*(prev = x++));
+                    }
+                }
+            }
+            else prev=x;
+            out = std::move(token);
+            return prev!=end;
+        };
+        auto isOperator = [operators = string("+-*%/")](const string & x){
+            return operators.find(x)!=string::npos;
+        };
+        auto lesserEqualPrecedence = [](const string & o1, const string & o2) -> bool{
+            switch(o2.front()){
+            case '+': case '-':
+                return (o1=="+" || o1=="-");
+            case '*': case '/': case '%':
+                return true;
+            }
+            return false;
+        };
+        std::vector<string> operationStack, postfixBuild;
+        string postfix, lparen{'(','[','{'}, rparen{')',']','}'};
+        std::istringstream inp(expr);
+        //while(x!=expr.cend() && *x==' ') ++x; //skip spaces at front of string
+        auto x = expr.cbegin();
+        string now;
+        //while (x!=expr.cend()){
+        while( getToken(now,x) ){
+            //while(x!=expr.cend() && *x==' ') ++x; //skip spaces after expression
+            if(isOperator(now)){
+                while( (!operationStack.empty()) &&
+                       isOperator(operationStack.back()) &&
+                       lesserEqualPrecedence(now, operationStack.back())){
+                    postfixBuild.push_back(std::move(operationStack.back()));
+                    operationStack.pop_back();
+                }
+                operationStack.push_back(std::move(now));
+            }
+            else if(now.front() == '@'){
+                operationStack.push_back(std::move(now));
+            }
+            else if(lparen.find(now)!=string::npos){
+                operationStack.push_back("(");
+            }
+            else if(now == ","){
+                while( (!operationStack.empty()) &&
+                       operationStack.back()!="("){
+                    postfixBuild.push_back(std::move(operationStack.back()));
+                    operationStack.pop_back();
+                }
+                if (operationStack.empty()){
+                    std::cerr << "Misplaced function separator found in " << expr;
+                    throw(invalid_expression_format("misplaced function argument separator - ','"));
+                }
+            }
+            else if(rparen.find(now)!=string::npos){
+                while( (!operationStack.empty()) &&
+                       operationStack.back()!="("){
+                    postfixBuild.push_back(std::move(operationStack.back()));
+                    operationStack.pop_back();
+                }
+                if (operationStack.empty()){
+                    std::cerr << "Mismatched right parethesis " << expr;
+                    throw(invalid_expression_format("mismatched right parethesis found"));
+                }
+                operationStack.pop_back(); // remove the left parenthesis
+                if ( (!operationStack.empty()) &&
+                     operationStack.back().front() == '@'){ // function call
+                    postfixBuild.push_back(std::move(operationStack.back()));
+                    operationStack.pop_back();
+                }
+            }
+            else{ //it's a number or something in place of a number
+                postfixBuild.push_back(std::move(now));
+            }
+        }
+        while(! operationStack.empty() ){
+            if (operationStack.back() == "(") throw(invalid_expression_format("mismatched left parethesis found"));
+            postfixBuild.push_back(std::move(operationStack.back()));
+            operationStack.pop_back();
+        }
+        for(auto it = postfixBuild.begin(); it!=postfixBuild.end(); ++it){
+            postfix.append(*it);
+            postfix.push_back(' ');
+        }
+        postfix.pop_back(); // remove last ' '
+        std::clog << "Built postfix expression: \"" << postfix << '"' << std::endl;
+        number<radix> retVal(eval_postfix(postfix));
+        return retVal;
+    }
+
+    template<unsigned char oradix>
+    /**
+     * @brief Converts numbers between radices
+     *
+     * Reads the limbs of other directly, without formatting and parsing
+     * text. The result keeps as many fractional digits as the string
+     * constructor would for other.str(), truncating the rest.
+     * @return Converted number
+     */
+    static number convert(const number<oradix> & other){
+        typedef detail::limb_arith<oradix> oarith;
+        number result;
+        result.isPositive = other.isPositive;
+        if (oradix == radix){
+            result.limbs = other.limbs;
+            result.frac_digits = other.frac_digits;
+            return result;
+        }
+        if (detail::radix_root(oradix) == regrouper::root){
+            // powers of a common root, the fraction is converted exactly
+            const unsigned p = detail::radix_exponent(oradix, regrouper::root);
+            result.frac_digits = (other.frac_digits * p + regrouper::exponent - 1) / regrouper::exponent;
+            regrouper packer(result.limbs);
+            packer.push(0, result.frac_digits * regrouper::exponent - other.frac_digits * p);
+            for (std::size_t i = 0; i < other.limbs.size(); ++i){
+                packer.push(other.limbs[i], oarith::digits * p);
+            }
+            packer.finish();
+            result.strip_zeroes();
+            return result;
+        }
+        // source limbs are split into groups of g digits, each smaller than base:
+        unsigned g = oarith::digits;
+        while (oarith::digits % g != 0 || detail::limb_pow(oradix, g) >= arith::base) --g;
+        const unsigned per = oarith::digits / g;
+        if (per == 1){
+            typedef std::reverse_iterator<const limb *> reverse;
+            result.limbs = arith::from_digits(reverse(other.limbs.end()), other.limbs.size(), oarith::base);
+        }
+        else{
+            const limb group = detail::limb_pow(oradix, g);
+            limb_vector groups(other.limbs.size() * per);
+            for (std::size_t j = 0; j < other.limbs.size(); ++j){
+                limb x = other.limbs[j];
+                for (unsigned i = 0; i < per; ++i, x /= group){
+                    groups[groups.size() - 1 - j * per - i] = x % group;
+                }
+            }
+            result.limbs = arith::from_digits(groups.begin(), groups.size(), group);
+        }
+        // fractional digits are converted by a single division by oradix^frac_digits:
+        const std::size_t fracnum = (oradix + radix - 1) / radix * other.frac_digits;
+        if (other.frac_digits != 0){
+            limb_vector quotient, remainder;
+            scale_up(result.limbs, fracnum);
+            arith::divrem_mag(result.limbs, arith::pow_mag(oradix, other.frac_digits), quotient, remainder);
+            result.limbs.swap(quotient);
+        }
+        result.frac_digits = fracnum;
+        result.strip_zeroes();
+        return result;
+    }
+
+    /**
+     * @brief Swaps number with other
+     * @param other number to swap with
+     */
+    void swap( number& other ){
+        limbs.swap(other.limbs);
+        std::swap(frac_digits, other.frac_digits);
+        std::swap(isPositive, other.isPositive);
+    }
+
+    template<typename T, typename = typename std::enable_if<detail::is_native_integer<T>::value ||
+                                                            std::is_floating_point<T>::value>::type>
+    /**
+     * @brief Converts the number to a native arithmetic type
+     *
+     * Integers are truncated towards zero, floating point values
+     * are correctly rounded, see to_native.
+     * @throw number_overflow if the number is out of range of T
+     */
+    explicit operator T() const{
+        T result;
+        if (to_native(*this, result) != std::errc()) throw(number_overflow());
+        return result;
+    }
+
+private:
+    template<unsigned char>
+    friend struct number;
+    template<unsigned char, std::size_t, std::size_t>
+    friend struct fixed_number;
+    template<unsigned char r>
+    friend from_chars_result from_chars(const char * first, const char * last, number<r> & value);
+    template<unsigned char r>
+    friend to_chars_result to_chars(char * first, char * last, const number<r> & value);
+    template<typename T, unsigned char r>
+    friend std::errc to_native(const number<r> & value, T & out);
+    template<unsigned char r>
+    friend to_chars_result serialize(char * first, char * last, const number<r> & value);
+    template<unsigned char r>
+    friend from_chars_result deserialize(const char * first, const char * last, number<r> & value);
+    template<unsigned char r>
+    friend std::istream& operator>>(std::istream& in, number<r> & ref);
+    template<unsigned char>
+    friend struct number_vector;
+
+    typedef detail::limb limb;
+    typedef detail::dlimb dlimb;
+    typedef detail::limb_vector limb_vector;
+    typedef detail::limb_arith<radix> arith;
+
+    limb_vector limbs; // magnitude scaled by radix^frac_digits, LITTLE_ENDIAN limbs
+    std::size_t frac_digits; // number of base-radix fractional digits
+    bool isPositive;
+
+    /**
+     * @brief Compares two numbers whithout taking sign into account
+     * @param other number to compare with
+     * @return 0 if equal, n<0 if *this<other, n>0 if *this>other
+     */
+    int cmp_ignore_sig(const number &other) const{
+        if(frac_digits == other.frac_digits){
+            return arith::cmp_mag(limbs, other.limbs);
+        }
+        // bring the number with less fractional digits to the same scale
+        if(frac_digits < other.frac_digits){
+            limb_vector tmp(limbs);
+            scale_up(tmp, other.frac_digits - frac_digits);
+            return arith::cmp_mag(tmp, other.limbs);
+        }
+        limb_vector tmp(other.limbs);
+        scale_up(tmp, frac_digits - other.frac_digits);
+        return arith::cmp_mag(limbs, tmp);
+    }
+
+    /**
+     * @brief Rise this number to the power of positive integer exponent
+     * @param exponent nubmer representing positive integer value
+     */
+    void int_pow(number && exponent){
+        number nula(0);
+        number orig(*this);
+        //naivní algoritmus
+        while(exponent > nula){
+            operator*=(orig);
+            --exponent;
+        }
+    }
+
+    /**
+     * @brief Adds other (or subtracts it if subtract is set) in native integers
+     *
+     * Handles operands of at most one limb whose fractional digits differ
+     * by less than one limb, their aligned magnitudes are below base^2.
+     * @return false if the operands are too large and nothing was done
+     */
+    bool add_small(const number & other, bool subtract){
+        if ( limbs.size() > 1 || other.limbs.size() > 1 ) return false;
+        const std::size_t frac = std::max(frac_digits, other.frac_digits);
+        if ( frac - std::min(frac_digits, other.frac_digits) >= arith::digits ) return false;
+        dlimb a = limbs.empty() ? 0 : static_cast<dlimb>(limbs[0]) * arith::power(frac - frac_digits);
+        dlimb b = other.limbs.empty() ? 0 : static_cast<dlimb>(other.limbs[0]) * arith::power(frac - other.frac_digits);
+        const bool otherPositive = (other.isPositive != subtract);
+        if ( isPositive == otherPositive ) a += b;
+        else if ( a >= b ) a -= b;
+        else{
+            a = b - a;
+            isPositive = otherPositive;
+        }
+        limbs.clear();
+        if ( a < arith::base ){
+            limbs.push_back(static_cast<limb>(a));
+        }
+        else{
+            limb low, high = arith::divmod_base(a, low);
+            limbs.push_back(low);
+            limbs.push_back(high);
+        }
+        frac_digits = frac;
+        strip_zeroes();
+        return true;
+    }
+
+    /**
+     * @brief Innermost scale_guard of the calling thread, nullptr if there is none
+     */
+    static scale_guard *& active_guard(){
+        static thread_local scale_guard * guard = nullptr;
+        return guard;
+    }
+
+    /**
+     * @brief Gets the magnitude of an integral value
+     * @param x the integral value
+     * @param mag output for the magnitude
+     * @return Whether the magnitude fits into a single limb, i.e. is less than base
+     */
+    template<typename T>
+    static bool native_limb(T x, limb & mag){
+        // computed in unsigned arithmetic so that minimal values don't overflow
+        unsigned long long m = static_cast<unsigned long long>(x);
+        if (!(x >= 0)) m = 0ull - m;
+        mag = m;
+        return m < arith::base;
+    }
+
+    /**
+     * @brief Adds mag, or -mag if positive is false, to this number in place
+     *
+     * The value mag*radix^frac_digits spans at most two limbs, the limbs
+     * of this number are only copied if the sign of the result changes.
+     * @param mag magnitude less than base
+     * @param positive sign of the added value
+     */
+    void add_native(limb mag, bool positive){
+        if (mag == 0) return;
+        if (limbs.empty()) isPositive = positive;
+        // align mag to the fractional digits:
+        const std::size_t offset = frac_digits / arith::digits;
+        limb part[2];
+        part[1] = arith::divmod_base(static_cast<dlimb>(mag)
+                                     * arith::power(frac_digits % arith::digits), part[0]);
+        const std::size_t n = (part[1] != 0) ? 2 : 1;
+        int cmp = (limbs.size() > offset + n) - (limbs.size() < offset + n);
+        if (cmp == 0) cmp = arith::cmp_n(limbs.data() + offset, part, n);
+        if (isPositive == positive){
+            if (limbs.size() < offset + n) limbs.resize(offset + n, 0);
+            limb carry = arith::add(limbs.data() + offset, limbs.data() + offset,
+                                    limbs.size() - offset, part, n);
+            if (carry != 0) limbs.push_back(carry);
+        }
+        else if (cmp >= 0){
+            // the fractional limbs below offset are left as they are
+            arith::sub(limbs.data() + offset, limbs.data() + offset,
+                       limbs.size() - offset, part, n);
+        }
+        else{
+            limb_vector difference(offset + n, 0);
+            std::copy(part, part + n, difference.begin() + offset);
+            arith::sub(difference.data(), difference.data(), difference.size(),
+                       limbs.data(), limbs.size());
+            limbs.swap(difference);
+            isPositive = positive;
+        }
+        strip_zeroes();
+    }
+
+    /**
+     * @brief Divides this by other and returns either the result of division or modulo based on the div parameter
+     *
+     * The quotient is truncated to current_scale() fractional digits, the
+     * modulo is the remainder of that truncated division and has the sign of this.
+     * @param other number to divide this by
+     * @param div whether division, or modulo shall be returned
+     * @return Result of division if div is true and result of modulo otherwise
+     */
+    number& div_or_mod(const number & other,bool div){
+        if(other.limbs.empty()) throw division_by_zero();
+
+        // this/other * radix^scale == (this.limbs * radix^(other.frac_digits+scale))
+        //                             / (other.limbs * radix^frac_digits)
+        // the common power of radix is cancelled out first
+        const std::size_t precision = current_scale();
+        std::size_t dividend_shift = other.frac_digits + precision;
+        std::size_t divisor_shift = frac_digits;
+        std::size_t common = std::min(dividend_shift, divisor_shift);
+        std::size_t remainder_frac = std::max(dividend_shift, divisor_shift);
+        dividend_shift -= common;
+        divisor_shift -= common;
+        bool quotientPositive = (isPositive == other.isPositive);
+
+        limb_vector dividend(limbs), divisor(other.limbs);
+        scale_up(dividend, dividend_shift);
+        scale_up(divisor, divisor_shift);
+        limb_vector quotient, remainder;
+        arith::divrem_mag(dividend, divisor, quotient, remainder);
+
+        if(div){
+            limbs.swap(quotient);
+            frac_digits = precision;
+            isPositive = quotientPositive;
+        }else{
+            limbs.swap(remainder);
+            frac_digits = remainder_frac;
+        }
+        strip_zeroes();
+        return *this;
+    }
+
+    /**
+     * @brief Strip leading and trailing 0
+     *
+     * Removes the most significant zero limbs and all trailing zero
+     * fractional digits, so that the representation of a value is unique.
+     *
+     * If the value is zero, also sets isPositive to true,
+     * so we are consistent with sign of zero.
+     */
+    void strip_zeroes(){
+        arith::trim(limbs);
+        if(limbs.empty()){
+            frac_digits = 0;
+            isPositive = true; // 0 is treated as positive
+            return;
+        }
+        // count trailing zero digits of the fractional part:
+        std::size_t zeroes = 0, i = 0;
+        while(zeroes + arith::digits <= frac_digits && limbs[i] == 0){
+            zeroes += arith::digits;
+            ++i;
+        }
+        for(limb x = limbs[i]; zeroes < frac_digits && x % radix == 0; x /= radix){
+            ++zeroes;
+        }
+        scale_down(limbs, zeroes);
+        frac_digits -= zeroes;
+    }
+
+    /**
+     * @brief Packs digit values into limbs
+     *
+     * Assigns the value of count digit values (0..radix-1, not characters),
+     * most significant first and the last fraction of them fractional,
+     * to the magnitude of this number, sign is left untouched.
+     */
+    void assign_digits(const unsigned char * v, std::size_t count, std::size_t fraction){
+        limbs.assign((count + arith::digits - 1) / arith::digits, 0);
+        for(std::size_t i = 0; i < limbs.size(); ++i){
+            // limb i holds the digits [count - (i+1)*digits, count - i*digits)
+            const std::size_t hi = count - i * arith::digits;
+            const std::size_t lo = (hi > arith::digits) ? hi - arith::digits : 0;
+            limbs[i] = arith::pack_digits(v + lo, static_cast<unsigned>(hi - lo));
+        }
+        frac_digits = fraction;
+        strip_zeroes();
+    }
+
+    /**
+     * @brief Assigns mantissa*2^exponent rounded to fracnum fractional digits
+     *
+     * Rounds to nearest, ties to even, sign is left untouched. A negative
+     * fracnum selects as many digits as the floating point constructor
+     * documents. Results that fit into 128 bits are computed directly,
+     * others by a division of magnitudes.
+     */
+    void assign_binary(detail::dlimb mantissa, int exponent, long long int fracnum){
+        typedef detail::dlimb dlimb;
+        limbs.clear();
+        frac_digits = 0;
+        if (mantissa == 0){
+            strip_zeroes();
+            return;
+        }
+        const std::size_t type_bits = (exponent < 0) ? -static_cast<long long>(exponent) : 0;
+        while ((mantissa & 1) == 0){
+            mantissa >>= 1;
+            ++exponent;
+        }
+        if (exponent >= 0){
+            // an integer, no rounding needed
+            assign_dlimb(limbs, mantissa);
+            if (exponent > 0) limbs = arith::mul_mag(limbs, arith::pow_mag(2, exponent));
+            strip_zeroes();
+            return;
+        }
+        const std::size_t k = -static_cast<long long>(exponent); // fractional bits
+        if (fracnum < 0){
+            // radix^fracnum must be divisible by 2^k, if that is possible at all
+            unsigned twos = 0;
+            for (unsigned r = radix; r % 2 == 0; r /= 2) ++twos;
+            fracnum = (twos != 0) ? (k + twos - 1) / twos : type_bits + 1;
+        }
+        const std::size_t f = static_cast<std::size_t>(fracnum);
+        // fast path, mantissa*radix^f and the quotient fit into 128 bits:
+        if (k < 128 && f < 2 * arith::digits){
+            const dlimb power = (f < arith::digits)
+                    ? static_cast<dlimb>(arith::power(f))
+                    : static_cast<dlimb>(arith::base) * arith::power(f - arith::digits);
+            if (mantissa <= ~static_cast<dlimb>(0) / power){
+                const dlimb scaled = mantissa * power;
+                dlimb q = scaled >> k;
+                const dlimb rem = scaled & ((static_cast<dlimb>(1) << k) - 1);
+                const dlimb half = static_cast<dlimb>(1) << (k - 1);
+                if (rem > half || (rem == half && (q & 1) != 0)) ++q;
+                if ((q >> 64) < arith::base){
+                    assign_dlimb(limbs, q);
+                    frac_digits = f;
+                    strip_zeroes();
+                    return;
+                }
+            }
+        }
+        limb_vector scaled, divisor = arith::pow_mag(2, k), rem;
+        assign_dlimb(scaled, mantissa);
+        scale_up(scaled, f);
+        arith::divrem_mag(scaled, divisor, limbs, rem);
+        // round to nearest, ties to even; the parity of an odd base is that of the limb sum
+        bool odd = false;
+        for (std::size_t i = 0; i < limbs.size(); ++i){
+            if (i == 0 || arith::base % 2 == 1) odd ^= (limbs[i] & 1) != 0;
+        }
+        arith::add_mag(rem, rem);
+        const int c = arith::cmp_mag(rem, divisor);
+        if (c > 0 || (c == 0 && odd)){
+            const limb carry = arith::add_1(limbs.data(), limbs.data(), limbs.size(), 1);
+            if (carry != 0) limbs.push_back(carry);
+        }
+        frac_digits = f;
+        strip_zeroes();
+    }
+
+    /**
+     * @brief Converts a 128-bit value smaller than base*2^64 to trimmed limbs
+     */
+    static void assign_dlimb(limb_vector & x, detail::dlimb value){
+        limb low;
+        const limb high = arith::divmod_base(value, low);
+        x.assign(3, 0);
+        x[0] = low;
+        x[1] = high % arith::base;
+        x[2] = high / arith::base;
+        arith::trim(x);
+    }
+
+    template<typename T>
+    /**
+     * @brief Converts to a native integer type, truncating towards zero
+     */
+    std::errc native_value(T & out, std::true_type) const{
+        const bool is_signed = std::is_signed<T>::value || std::is_same<T, __int128>::value;
+        const dlimb max = is_signed ? (static_cast<dlimb>(1) << (sizeof(T) * 8 - 1)) - 1
+                                    : static_cast<dlimb>(static_cast<T>(~static_cast<T>(0)));
+        const dlimb limit = isPositive ? max : (is_signed ? max + 1 : 0);
+        dlimb magnitude;
+        if (!whole_magnitude(magnitude) || magnitude > limit) return std::errc::result_out_of_range;
+        out = static_cast<T>(isPositive ? magnitude : 0 - magnitude);
+        return std::errc();
+    }
+
+    template<typename T>
+    /**
+     * @brief Converts to a floating point type, rounding to nearest
+     */
+    std::errc native_value(T & out, std::false_type) const{
+        T magnitude;
+        const bool fits = native_float(magnitude);
+        out = isPositive ? magnitude : -magnitude;
+        return fits ? std::errc() : std::errc::result_out_of_range;
+    }
+
+    /**
+     * @brief Calculates the magnitude of the whole part
+     *
+     * Reads limbs from the most significant one and stops as soon as the
+     * whole part is known not to fit.
+     * @param out output for the magnitude
+     * @return false if the whole part does not fit into 128 bits
+     */
+    bool whole_magnitude(dlimb & out) const{
+        // limbs above the radix point divided by p = radix^b, base = p*m:
+        const std::size_t a = frac_digits / arith::digits;
+        const unsigned b = frac_digits % arith::digits;
+        const limb p = arith::power(b);
+        const limb m = (b == 0) ? 0 : arith::power(arith::digits - b);
+        dlimb q = 0;
+        limb r = 0;
+        for (std::size_t i = limbs.size(); i-- > a; ){
+            if (__builtin_mul_overflow(q, static_cast<dlimb>(arith::base), &q) ||
+                    __builtin_add_overflow(q, static_cast<dlimb>(r) * m + limbs[i] / p, &q)){
+                return false;
+            }
+            r = limbs[i] % p;
+        }
+        out = q;
+        return true;
+    }
+
+    template<typename T>
+    /**
+     * @brief Rounds the magnitude to the nearest value of type T
+     *
+     * Small magnitudes with few fractional digits take one floating point
+     * division, which is correctly rounded. Others are rounded from their
+     * three leading limbs in binary words when the remaining limbs cannot
+     * change the result, otherwise from all limbs.
+     * @return false if the magnitude overflows to infinity
+     */
+    bool native_float(T & out) const{
+        const int bits = std::numeric_limits<T>::digits;
+        if (limbs.empty()){
+            out = 0;
+            return true;
+        }
+        if (limbs.size() <= 2 && frac_digits < 2 * arith::digits){
+            // both operands are exact in T, e.g. up to 22 decimal places for double
+            const dlimb mantissa = limbs[0] + (limbs.size() == 2 ? static_cast<dlimb>(limbs[1]) * arith::base : 0);
+            const dlimb divisor = (frac_digits < arith::digits)
+                    ? static_cast<dlimb>(arith::power(frac_digits))
+                    : static_cast<dlimb>(arith::base) * arith::power(frac_digits - arith::digits);
+            dlimb odd = divisor;
+            while ((odd & 1) == 0) odd >>= 1;
+            if ((mantissa >> bits) == 0 && (odd >> bits) == 0){
+                out = static_cast<T>(mantissa) / static_cast<T>(divisor);
+                return true;
+            }
+        }
+        const std::size_t kept = std::min<std::size_t>(limbs.size(), 3);
+        const std::size_t dropped = limbs.size() - kept;
+        const bool truncated = std::any_of(limbs.data(), limbs.data() + dropped, [](limb l){ return l != 0; });
+        const long long e = static_cast<long long>(dropped * arith::digits) - static_cast<long long>(frac_digits);
+        if (!round_words(limbs.data() + dropped, kept, e, truncated, out)){
+            round_scaled(limbs, -static_cast<long long>(frac_digits), out);
+        }
+        return out != std::numeric_limits<T>::infinity();
+    }
+
+    /**
+     * @brief Fixed size binary magnitude for rounding to floating point types
+     */
+    struct binary_words{
+        static constexpr std::size_t capacity = 24;
+        limb w[capacity];
+        std::size_t size;
+
+        /**
+         * @brief Converts at most three base-radix limbs
+         */
+        binary_words(const limb * x, std::size_t n): size(0){
+            while (n-- > 0){
+                mul(arith::base);
+                add(x[n]);
+            }
+        }
+        void add(limb b){
+            for (std::size_t i = 0; i < size && b != 0; ++i){
+                w[i] += b;
+                b = (w[i] < b) ? 1 : 0;
+            }
+            if (b != 0) w[size++] = b;
+        }
+        void sub_1(){
+            std::size_t i = 0;
+            while (w[i] == 0) w[i++] = ~static_cast<limb>(0);
+            --w[i];
+            while (size > 0 && w[size - 1] == 0) --size;
+        }
+        void mul(limb m){
+            limb carry = 0;
+            for (std::size_t i = 0; i < size; ++i){
+                const dlimb t = static_cast<dlimb>(w[i]) * m + carry;
+                w[i] = static_cast<limb>(t);
+                carry = static_cast<limb>(t >> 64);
+            }
+            if (carry != 0) w[size++] = carry;
+        }
+        void shift_left(std::size_t n){
+            const std::size_t words = n / 64;
+            const unsigned part = n % 64;
+            w[size] = 0;
+            for (std::size_t i = size + 1; i-- > 0; ){
+                const limb below = (part != 0 && i > 0) ? w[i - 1] >> (64 - part) : 0;
+                w[i + words] = (w[i] << part) | below;
+            }
+            std::fill(w, w + words, 0);
+            size += words + 1;
+            while (size > 0 && w[size - 1] == 0) --size;
+        }
+        /**
+         * @brief Divides by base, or by radix^k if k is nonzero
+         * @return true if the remainder is nonzero
+         */
+        bool div(unsigned k){
+            limb rem = 0;
+            for (std::size_t i = size; i-- > 0; ){
+                const dlimb t = (static_cast<dlimb>(rem) << 64) | w[i];
+                if (k == 0) w[i] = arith::divmod_base(t, rem);
+                else{
+                    w[i] = static_cast<limb>(t / arith::power(k));
+                    rem = static_cast<limb>(t % arith::power(k));
+                }
+            }
+            while (size > 0 && w[size - 1] == 0) --size;
+            return rem != 0;
+        }
+        std::size_t bit_length() const{
+            return size == 0 ? 0 : size * 64 - __builtin_clzll(w[size - 1]);
+        }
+        bool bit(std::size_t i) const{
+            return (w[i / 64] >> (i % 64)) & 1;
+        }
+        bool any_below(std::size_t i) const{
+            for (std::size_t j = 0; j < i / 64; ++j) if (w[j] != 0) return true;
+            return (w[i / 64] & ((static_cast<limb>(1) << (i % 64)) - 1)) != 0;
+        }
+        /**
+         * @brief Bits from i upwards, at most 128 of them
+         */
+        dlimb from(std::size_t i) const{
+            dlimb r = 0;
+            for (std::size_t j = size; j-- > i / 64; ) r = (r << 64) | w[j];
+            return r >> (i % 64);
+        }
+
+        template<typename T>
+        /**
+         * @brief Rounds value*2^-s to nearest, ties to even
+         * @param sticky true if the value lies strictly between these words and the next integer
+         */
+        T round(long long s, bool sticky) const{
+            const int bits = std::numeric_limits<T>::digits;
+            const long long min_exponent = std::numeric_limits<T>::min_exponent - 1;
+            const long long length = static_cast<long long>(bit_length());
+            long long shift = length - bits;
+            if (length - 1 - s < min_exponent) shift += min_exponent - (length - 1 - s);
+            if (shift > length) return 0;
+            dlimb mantissa = from(static_cast<std::size_t>(shift));
+            if (bit(static_cast<std::size_t>(shift - 1)) &&
+                    (sticky || (mantissa & 1) != 0 || any_below(static_cast<std::size_t>(shift - 1)))){
+                ++mantissa;
+            }
+            return std::ldexp(static_cast<T>(mantissa), static_cast<int>(shift - s));
+        }
+    };
+
+    template<typename T>
+    /**
+     * @brief Rounds x*radix^e to nearest, ties to even, without allocating memory
+     * @param x magnitude of at most three limbs
+     * @param truncated true if the value lies strictly between x*radix^e and (x+1)*radix^e
+     * @param out output
+     * @return false if the words cannot hold the value, or it is truncated
+     * and both ends of its interval do not round alike
+     */
+    static bool round_words(const limb * x, std::size_t n, long long e, bool truncated, T & out){
+        const int bits = std::numeric_limits<T>::digits;
+        static const double log_radix = std::log2(static_cast<double>(radix));
+        const binary_words value(x, n);
+        const long long length = static_cast<long long>(value.bit_length());
+        // scale by 2^s, so the value has at least bits+4 whole bits:
+        const long long scale_bits = static_cast<long long>(std::ceil(std::abs(e) * log_radix));
+        const long long s = std::max(0ll, (e < 0) ? bits + 5 + scale_bits - length : bits + 6 - length - scale_bits);
+        if (length + std::max(s, scale_bits) + 64 > static_cast<long long>(binary_words::capacity * 64)) return false;
+        T ends[2];
+        for (int end = 0; end < (truncated ? 2 : 1); ++end){
+            // the lower end is x*radix^e, the upper one is just below (x+1)*radix^e
+            binary_words words = value;
+            if (end == 1) words.add(1);
+            bool sticky = truncated;
+            if (e >= 0){
+                for (long long k = e; k > 0; k -= arith::digits){
+                    words.mul(k >= arith::digits ? arith::base : arith::power(static_cast<unsigned>(k)));
+                }
+                words.shift_left(static_cast<std::size_t>(s));
+                if (end == 1) words.sub_1();
+            }
+            else{
+                words.shift_left(static_cast<std::size_t>(s));
+                if (end == 1) words.sub_1();
+                for (long long k = -e; k > 0; k -= arith::digits){
+                    sticky |= words.div(k >= arith::digits ? 0 : static_cast<unsigned>(k));
+                }
+            }
+            if (words.bit_length() < static_cast<std::size_t>(bits) + 2) return false;
+            ends[end] = words.template round<T>(s, sticky);
+        }
+        out = ends[0];
+        return !truncated || ends[0] == ends[1];
+    }
+
+    template<typename T>
+    /**
+     * @brief Rounds x*radix^e to nearest, ties to even, for any size of x and e
+     * @param x nonzero magnitude
+     * @param out output, infinity on overflow
+     */
+    static void round_scaled(const limb_vector & x, long long e, T & out){
+        const int bits = std::numeric_limits<T>::digits;
+        const int min_exponent = std::numeric_limits<T>::min_exponent - 1;
+        // log2 of the value, overestimated by at most one:
+        static const double log_radix = std::log2(static_cast<double>(radix));
+        const double estimate = (64 - __builtin_clzll(x.back())) +
+                (static_cast<double>(x.size() - 1) * arith::digits + e) * log_radix;
+        if (estimate > std::numeric_limits<T>::max_exponent + 3){
+            out = std::numeric_limits<T>::infinity();
+            return;
+        }
+        if (estimate < min_exponent - bits - 3){
+            out = 0;
+            return;
+        }
+        // q = floor(x * radix^e * 2^s) with bits+2 to bits+6 bits:
+        long long s = bits + 3 - static_cast<long long>(std::floor(estimate));
+        while (true){
+            limb_vector num = x, den(1, 1), quot, rem;
+            if (e > 0) scale_up(num, e);
+            if (e < 0) scale_up(den, -e);
+            if (s > 0) scale_pow2(num, s);
+            if (s < 0) scale_pow2(den, -s);
+            arith::divrem_mag(num, den, quot, rem);
+            const binary_words q(quot.data(), quot.size());
+            const long long length = static_cast<long long>(q.bit_length());
+            if (quot.size() > 3 || length > bits + 6) s -= length - bits - 3;
+            else if (length < bits + 2) s += bits + 3 - length;
+            else{
+                out = q.template round<T>(s, !rem.empty());
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Reads digit values of radix rdx with at most one radix point
+     *
+     * Characters are translated by detail::scan_digits in fixed size chunks,
+     * so a far away last costs nothing.
+     * @param digit_values output for the digit values, whole part followed by the fractional part
+     * @param whole_count  output for the number of whole digits
+     * @return Pointer to the first character that was not read
+     */
+    static const char * read_digits(const char * first, const char * last, unsigned rdx,
+                                    std::string & digit_values, std::size_t & whole_count){
+        digit_values.clear();
+        bool onDecimal = false;
+        unsigned char chunk[256];
+        while (true){
+            const char * end = first + std::min(static_cast<std::size_t>(last - first), sizeof(chunk));
+            const char * stop = detail::scan_digits(first, end, rdx, chunk);
+            digit_values.append(reinterpret_cast<const char *>(chunk), stop - first);
+            first = stop;
+            if (first == last) break;
+            if (stop == end) continue;
+            const unsigned char c = static_cast<unsigned char>(*first);
+            if (onDecimal || c >= 128 || values[c] != -2) break;
+            onDecimal = true;
+            whole_count = digit_values.size();
+            ++first;
+        }
+        if (!onDecimal) whole_count = digit_values.size();
+        return first;
+    }
+
+    /**
+     * @brief Reads digits of radix with at most one radix point into this number
+     *
+     * Like read_digits, but the digits are packed straight into limbs,
+     * reusing their capacity. Sign is left untouched.
+     * @return Pointer to the first character that was not read
+     */
+    const char * read_packed(const char * first, const char * last){
+        digit_packer packer(limbs);
+        frac_digits = 0;
+        bool onDecimal = false;
+        unsigned char chunk[256];
+        while (true){
+            const char * end = first + std::min(static_cast<std::size_t>(last - first), sizeof(chunk));
+            const char * stop = detail::scan_digits(first, end, radix, chunk);
+            packer.push(chunk, stop - first);
+            if (onDecimal) frac_digits += stop - first;
+            first = stop;
+            if (first == last) break;
+            if (stop == end) continue;
+            const unsigned char c = static_cast<unsigned char>(*first);
+            if (onDecimal || c >= 128 || values[c] != -2) break;
+            onDecimal = true;
+            ++first;
+        }
+        packer.finish();
+        strip_zeroes();
+        return first;
+    }
+
+    /**
+     * @brief Number of significant digits of the magnitude
+     */
+    std::size_t digit_count() const{
+        if (limbs.empty()) return 0;
+        return (limbs.size() - 1) * arith::digits + arith::digit_count(limbs.back());
+    }
+
+    /**
+     * @brief Number of written digits, at least one whole digit and all fractional ones
+     */
+    std::size_t digit_total() const{
+        return std::max(digit_count(), frac_digits + 1);
+    }
+
+    /**
+     * @brief Length of the string representation with total digits
+     */
+    std::size_t str_length(std::size_t total) const{
+        return ((radix >= 10) ? 4 : 3) + (isPositive ? 0 : 1) + total + (frac_digits != 0 ? 1 : 0);
+    }
+
+    /**
+     * @brief Writes the string representation
+     * @param out   buffer with room for str_length(total) characters
+     * @param total digit_total()
+     * @return Pointer past the written characters
+     */
+    char * write_str(char * out, std::size_t total) const{
+        if (radix >= 10) *out++ = static_cast<char>('0' + radix / 10);
+        *out++ = static_cast<char>('0' + radix % 10);
+        *out++ = ':';
+        *out++ = ':';
+        if (!isPositive) *out++ = '-';
+        // digits are written from the least significant one, two at a time:
+        const char * pairs = digit_pairs();
+        char * p = out + total;
+        for (std::size_t k = 0; p != out; ++k){
+            limb x = (k < limbs.size()) ? limbs[k] : 0;
+            std::size_t n = std::min<std::size_t>(arith::digits, p - out);
+            for (; n >= 2; n -= 2){
+                const limb rem = x % (radix * radix);
+                x /= radix * radix;
+                p -= 2;
+                p[0] = pairs[2 * rem];
+                p[1] = pairs[2 * rem + 1];
+            }
+            if (n != 0) *--p = digits[x % radix];
+        }
+        if (frac_digits == 0) return out + total;
+        // make room for the radix point:
+        std::copy_backward(out + total - frac_digits, out + total, out + total + 1);
+        out[total - frac_digits] = '.';
+        return out + total + 1;
+    }
+
+    /**
+     * @brief Characters of all two digit values, most significant first
+     */
+    static const char * digit_pairs(){
+        static const struct pair_table{
+            char value[2 * radix * radix];
+            pair_table(){
+                for (unsigned v = 0; v < radix * radix; ++v){
+                    value[2 * v] = digits[v / radix];
+                    value[2 * v + 1] = digits[v % radix];
+                }
+            }
+        } table;
+        return table.value;
+    }
+
+    /**
+     * @brief Multiplies magnitude by radix^n
+     */
+    static void scale_up(limb_vector & x, std::size_t n){
+        if(x.empty() || n == 0) return;
+        unsigned part = n % arith::digits;
+        if(part != 0){
+            limb carry = arith::mul_pow(x.data(), x.data(), x.size(), part);
+            if(carry != 0) x.push_back(carry);
+        }
+        x.insert(x.begin(), n / arith::digits, 0);
+    }
+
+    /**
+     * @brief Multiplies magnitude by 2^n
+     */
+    static void scale_pow2(limb_vector & x, std::size_t n){
+        if (n > 2048){
+            x = arith::mul_mag(x, arith::pow_mag(2, n));
+            return;
+        }
+        for (; n != 0; n -= std::min<std::size_t>(n, 32)){
+            const limb carry = arith::mul_1(x.data(), x.data(), x.size(), static_cast<limb>(1) << std::min<std::size_t>(n, 32));
+            if (carry != 0) x.push_back(carry);
+        }
+    }
+
+    /**
+     * @brief Divides magnitude by radix^n, discarding the remainder
+     */
+    static void scale_down(limb_vector & x, std::size_t n){
+        if(n == 0) return;
+        std::size_t whole = n / arith::digits;
+        if(whole >= x.size()){
+            x.clear();
+            return;
+        }
+        x.erase(x.begin(), x.begin() + whole);
+        unsigned part = n % arith::digits;
+        if(part != 0){
+            arith::divrem_pow(x.data(), x.data(), x.size(), part);
+        }
+        arith::trim(x);
+    }
+
+    /**
+     * @brief Collects digits of the root of radix into limbs
+     *
+     * Radices that are powers of a common root (2, 4, 8, 16, 32, 64 or
+     * 3, 9, 27) are converted by regrouping root digits, in linear time
+     * and without arithmetic on the whole magnitude.
+     * Digits are pushed least significant first.
+     */
+    struct regrouper{
+        /**
+         * @brief Smallest root such that radix is its power
+         */
+        static constexpr unsigned root = detail::radix_root(radix);
+
+        /**
+         * @brief Number of root digits per radix digit
+         */
+        static constexpr unsigned exponent = detail::radix_exponent(radix, root);
+
+        explicit regrouper(limb_vector & target):
+            out(target),
+            acc(0),
+            filled(0)
+        {
+            out.clear();
+        }
+
+        /**
+         * @brief Appends count root digits of value, value < root^count
+         */
+        void push(limb value, std::size_t count){
+            while (count > 0){
+                const std::size_t room = per_limb - filled;
+                if (count < room){
+                    acc += value * root_pow(filled);
+                    filled += count;
+                    return;
+                }
+                // the limb is complete, the rest of value goes to the next one
+                const limb split = root_pow(room);
+                out.push_back(acc + value % split * root_pow(filled));
+                value /= split;
+                count -= room;
+                acc = 0;
+                filled = 0;
+            }
+        }
+
+        /**
+         * @brief Stores the last partial limb, trims the result
+         */
+        void finish(){
+            if (filled != 0) out.push_back(acc);
+            arith::trim(out);
+        }
+
+    private:
+        static constexpr std::size_t per_limb = std::size_t(arith::digits) * exponent;
+
+        /**
+         * @brief Calculates root^k for k <= per_limb
+         */
+        static limb root_pow(std::size_t k){
+            typedef detail::limb_arith<root> rarith;
+            return (k < rarith::digits) ? rarith::power(k) : rarith::base;
+        }
+
+        limb_vector & out;
+        limb acc;
+        std::size_t filled;
+    };
+
+    /**
+     * @brief Packs digit values of radix into limbs
+     *
+     * Digits are pushed most significant first. Complete limbs are stored
+     * in reading order and put in place by finish() once the number of
+     * digits is known, so the digits need not be buffered and the
+     * capacity of the target is reused.
+     */
+    struct digit_packer{
+        explicit digit_packer(limb_vector & target):
+            out(target)
+        {
+            clear();
+        }
+
+        /**
+         * @brief Drops all pushed digits
+         */
+        void clear() noexcept{
+            out.clear();
+            acc = 0;
+            filled = 0;
+        }
+
+        /**
+         * @brief Appends a single digit value
+         */
+        void push(limb value){
+            acc = acc * radix + value;
+            if (++filled == arith::digits) store();
+        }
+
+        /**
+         * @brief Appends n digit values
+         */
+        void push(const unsigned char * v, std::size_t n){
+            while (n > 0){
+                const unsigned k = static_cast<unsigned>(std::min<std::size_t>(n, arith::digits - filled));
+                const limb part = arith::pack_digits(v, k);
+                // a partial acc has room for k more digits:
+                acc = (filled == 0) ? part : acc * arith::power(k) + part;
+                filled += k;
+                v += k;
+                n -= k;
+                if (filled == arith::digits) store();
+            }
+        }
+
+        /**
+         * @brief Puts the limbs in order and appends the last partial limb, trims the result
+         */
+        void finish(){
+            std::reverse(out.begin(), out.end());
+            if (filled != 0){
+                // without complete limbs add_1 returns acc itself:
+                limb top = arith::mul_1(out.data(), out.data(), out.size(), arith::power(filled));
+                top += arith::add_1(out.data(), out.data(), out.size(), acc);
+                out.push_back(top);
+            }
+            arith::trim(out);
+        }
+
+    private:
+        void store(){
+            out.push_back(acc);
+            acc = 0;
+            filled = 0;
+        }
+
+        limb_vector & out;
+        limb acc;
+        unsigned filled;
+    };
+
+    /**
+     * @brief Regroups digit values of radix rdx and assigns them to the magnitude
+     *
+     * Both rdx and radix must be powers of regrouper::root, the fraction
+     * is converted exactly and then truncated to fracnum digits.
+     * Sign is left untouched.
+     * @param whole   Digit values of the whole part as BIG ENDIAN (least significant first)
+     * @param decimal Digit values of the fractional part as LITTLE ENDIAN
+     * @param rdx     Radix of the digits
+     * @param fracnum Number of fractional digits to keep
+     */
+    void assign_regrouped(const std::string & whole,
+                          const std::string & decimal,
+                          unsigned int rdx,
+                          std::size_t fracnum){
+        const unsigned p = detail::radix_exponent(rdx, regrouper::root);
+        frac_digits = (decimal.size() * p + regrouper::exponent - 1) / regrouper::exponent;
+        regrouper packer(limbs);
+        packer.push(0, frac_digits * regrouper::exponent - decimal.size() * p);
+        for (auto x = decimal.crbegin(); x != decimal.crend(); ++x){
+            packer.push(static_cast<unsigned char>(*x), p);
+        }
+        for (auto x = whole.cbegin(); x != whole.cend(); ++x){
+            packer.push(static_cast<unsigned char>(*x), p);
+        }
+        packer.finish();
+        if (frac_digits > fracnum){
+            scale_down(limbs, frac_digits - fracnum);
+            frac_digits = fracnum;
+        }
+        strip_zeroes();
+    }
+
+    /**
+     * @brief Converts digit values of radix rdx and assigns them to the magnitude
+     *
+     * The whole part and the numerator of the fraction are converted by
+     * arith::from_digits in subquadratic time, the fraction is then
+     * truncated to fracnum digits by a single division by rdx^decimal.size().
+     * Sign is left untouched.
+     * @param whole   Digit values of the whole part as BIG ENDIAN (least significant first)
+     * @param decimal Digit values of the fractional part as LITTLE ENDIAN
+     * @param rdx     Radix of the digits
+     * @param fracnum Number of fractional digits to keep
+     */
+    void assign_converted(const std::string & whole,
+                          const std::string & decimal,
+                          unsigned int rdx,
+                          std::size_t fracnum){
+        limbs = arith::from_digits(whole.crbegin(), whole.size(), rdx);
+        scale_up(limbs, fracnum);
+        // trailing zeroes of the fraction don't change its value:
+        const std::size_t used = decimal.find_last_not_of('\0') + 1;
+        if (used != 0 && fracnum != 0){
+            limb_vector numerator = arith::from_digits(decimal.cbegin(), used, rdx);
+            scale_up(numerator, fracnum);
+            limb_vector quotient, remainder;
+            arith::divrem_mag(numerator, arith::pow_mag(rdx, used), quotient, remainder);
+            arith::add_mag(limbs, quotient);
+        }
+        frac_digits = fracnum;
+        strip_zeroes();
+    }
+
+    /**
+     * @brief Assigns digit values of radix rdx to the magnitude
+     *
+     * Keeps as many fractional digits as the string constructor does and
+     * picks assign_regrouped or assign_converted. Sign is left untouched.
+     * @param digit_values Digit values, whole part followed by the fractional part
+     * @param whole_count  Number of whole digits
+     * @param rdx          Radix of the digits
+     */
+    void assign_other_radix(const std::string & digit_values, std::size_t whole_count, unsigned int rdx){
+        std::string whole(digit_values.crend() - whole_count, digit_values.crend());
+        std::string decimal(digit_values, whole_count);
+        const std::size_t fracnum = (rdx + radix - 1) / radix * decimal.size();
+        if (detail::radix_root(rdx) == regrouper::root) assign_regrouped(whole, decimal, rdx, fracnum);
+        else assign_converted(whole, decimal, rdx, fracnum);
+    }
+
+    /**
+     * @brief Reads a number for operator>>
+     *
+     * Consumes characters of the format of from_chars from buf and stops
+     * at the first one that does not belong to the number. Digits in radix
+     * are packed into limbs by digit_packer as they are read, so no
+     * characters are buffered and the capacity of limbs is reused.
+     * Leading decimal digits are packed too until "::" shows they were
+     * a radix prefix; as they can't be given back, one that is not valid
+     * in radix fails without it.
+     * Digits of other radices are collected and converted by assign_other_radix.
+     * @param buf stream buffer positioned at the number
+     * @return State bits to be set on the stream, failbit if there was
+     * no number, in which case this number becomes zero
+     */
+    std::ios_base::iostate extract(std::streambuf & buf){
+        typedef std::char_traits<char> traits;
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        digit_packer packer(limbs);
+        frac_digits = 0;
+        bool any = false;
+        bool malformed = false;
+        bool onDecimal = false;
+        std::string other;          // digit values of a radix other than radix
+        std::size_t whole_count = 0;
+        unsigned rdx = radix;
+        bool inPrefix = true;
+        bool prefixOnly = false;    // a leading digit was not valid in radix
+        unsigned prefix = 0;
+        bool negative = false;
+        traits::int_type c = buf.sgetc();
+        if (traits::eq_int_type(c, traits::to_int_type('-'))){
+            negative = true;
+            c = buf.snextc();
+            // like from_chars, a second sign rules out the radix prefix:
+            if (traits::eq_int_type(c, traits::to_int_type('-'))){
+                inPrefix = false;
+                c = buf.snextc();
+            }
+        }
+        while (true){
+            if (traits::eq_int_type(c, traits::eof())){
+                state |= std::ios_base::eofbit;
+                break;
+            }
+            const unsigned char ch = static_cast<unsigned char>(traits::to_char_type(c));
+            const int v = (ch < 128) ? values[ch] : -1;
+            if (inPrefix && ch >= '0' && ch <= '9'){
+                prefix = std::min(prefix * 10 + (ch - '0'), unsigned(MAX_RADIX) + 1);
+                if (static_cast<unsigned>(ch - '0') >= rdx) prefixOnly = true;
+            }
+            else if (inPrefix && ch == ':' && any){
+                c = buf.snextc();
+                if (!traits::eq_int_type(c, traits::to_int_type(':'))){
+                    // a lone colon ends the number, if it can be given back
+                    malformed = traits::eq_int_type(buf.sungetc(), traits::eof());
+                    break;
+                }
+                if (prefix < 2 || prefix > MAX_RADIX){
+                    malformed = true;
+                    break;
+                }
+                rdx = prefix;
+                inPrefix = prefixOnly = any = false;
+                packer.clear();
+                c = buf.snextc();
+                if (traits::eq_int_type(c, traits::to_int_type('-'))){
+                    negative = true;
+                    c = buf.snextc();
+                }
+                continue;
+            }
+            else if (v == -2 && !onDecimal && !prefixOnly){
+                inPrefix = false;
+                onDecimal = true;
+                whole_count = other.size();
+                c = buf.snextc();
+                continue;
+            }
+            else if (v < 0 || static_cast<unsigned>(v) >= rdx){
+                break;
+            }
+            else{
+                inPrefix = false;
+            }
+            if (!prefixOnly){
+                if (rdx != radix){
+                    other.push_back(static_cast<char>(v));
+                }
+                else{
+                    packer.push(static_cast<limb>(v));
+                    if (onDecimal) ++frac_digits;
+                }
+            }
+            any = true;
+            c = buf.snextc();
+        }
+        if (!any || prefixOnly || malformed){
+            limbs.clear();
+            frac_digits = 0;
+            isPositive = true;
+            return state | std::ios_base::failbit;
+        }
+        if (rdx != radix){
+            if (!onDecimal) whole_count = other.size();
+            assign_other_radix(other, whole_count, rdx);
+        }
+        else{
+            packer.finish();
+            strip_zeroes();
+        }
+        isPositive = !negative || limbs.empty();
+        return state;
+    }
+
+};
+
+template<unsigned char radix>
+constexpr unsigned number<radix>::regrouper::root;
+template<unsigned char radix>
+constexpr unsigned number<radix>::regrouper::exponent;
+template<unsigned char radix>
+constexpr std::size_t number<radix>::regrouper::per_limb;
+
+template<unsigned char radix>
+bool operator <=(const number<radix>& lhs,const number<radix> & rhs){
+    return ( ! ( rhs < lhs ) );
+}
+
+template<unsigned char radix>
+bool operator !=(const number<radix>& lhs,const number<radix> & rhs){
+    return ( ! ( lhs == rhs ) );
+}
+
+template<unsigned char radix>
+bool operator >(const number<radix>& lhs,const number<radix> & rhs){
+    return ( rhs < lhs );
+}
+
+template<unsigned char radix>
+bool operator >=(const number<radix>& lhs,const number<radix> & rhs){
+    return ( ! ( lhs < rhs ) );
+}
+
+template<unsigned char radix>
+number<radix> operator +(const number<radix> & lhs,
+                         const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum+=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator +(const number<radix> & lhs, T rhs){
+    number<radix> newnum(lhs);
+    newnum+=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator +(T lhs, const number<radix> & rhs){
+    number<radix> newnum(rhs);
+    newnum+=lhs;
+    return newnum;
+}
+
+template<unsigned char radix>
+number<radix> operator -(const number<radix> & lhs,
+                         const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum-=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator -(const number<radix> & lhs, T rhs){
+    number<radix> newnum(lhs);
+    newnum-=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator -(T lhs, const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum-=rhs;
+    return newnum;
+}
+
+template<unsigned char radix>
+number<radix> operator *(const number<radix> & lhs,
+                         const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum*=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator *(const number<radix> & lhs, T rhs){
+    number<radix> newnum(lhs);
+    newnum*=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator *(T lhs, const number<radix> & rhs){
+    number<radix> newnum(rhs);
+    newnum*=lhs;
+    return newnum;
+}
+
+template<unsigned char radix>
+number<radix> operator /(const number<radix> & lhs,
+                         const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum/=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator /(const number<radix> & lhs, T rhs){
+    number<radix> newnum(lhs);
+    newnum/=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator /(T lhs, const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum/=rhs;
+    return newnum;
+}
+
+template<unsigned char radix>
+number<radix> operator %(const number<radix> & lhs,
+                         const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum%=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator %(const number<radix> & lhs, T rhs){
+    number<radix> newnum(lhs);
+    newnum%=rhs;
+    return newnum;
+}
+template<unsigned char radix,
+         typename T,
+         typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+number<radix> operator %(T lhs, const number<radix> & rhs){
+    number<radix> newnum(lhs);
+    newnum%=rhs;
+    return newnum;
+}
+
+template<unsigned char radix>
+std::ostream& operator<<(std::ostream& out, const number<radix> & ref){
+    // short numbers are formatted on the stack, padding needs the string
+    if (out.width() == 0){
+        char buffer[128];
+        const to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), ref);
+        if (r.ec == std::errc()) return out.write(buffer, r.ptr - buffer);
+    }
+    out << ref.str();
+    return out;
+}
+
+template<unsigned char radix>
+/**
+ * @brief Extracts a number straight from the stream buffer
+ *
+ * Skips whitespace as formatted input does, then reads the format of
+ * from_chars and leaves the first character not belonging to the number
+ * in the stream. The storage of ref is reused.
+ * Malformed input sets failbit and makes ref zero instead of throwing.
+ */
+std::istream& operator>>(std::istream& in, number<radix> & ref){
+    const std::istream::sentry guard(in);
+    if (guard) in.setstate(ref.extract(*in.rdbuf()));
+    return in;
+}
+
+template<unsigned char radix>
+/**
+ * @brief Parses a number without throwing or printing diagnostics
+ *
+ * Accepts the format of the string constructor, [-][RR::][-]digits[.digits],
+ * and stops at the first character that does not belong to it.
+ * The characters are read in a single pass. Numbers in radix are packed
+ * straight into the limbs of value, reusing their capacity, once the first
+ * digit is known to be there. Numbers in other radices are converted as
+ * by the string constructor.
+ * @param first beginning of the characters
+ * @param last  end of the characters
+ * @param value output, left untouched on error
+ * @return Pointer past the number and std::errc() on success, first and
+ * std::errc::invalid_argument if there is no number or its radix is invalid
+ */
+from_chars_result from_chars(const char * first, const char * last, number<radix> & value){
+    const from_chars_result invalid{first, std::errc::invalid_argument};
+    const char * p = first;
+    bool negative = (p != last && *p == '-');
+    if (negative) ++p;
+    // optional radix prefix, always decimal, its digits are found by the digit scanner:
+    const char * q = p;
+    unsigned char chunk[256];
+    while (q != last){
+        const char * end = q + std::min(static_cast<std::size_t>(last - q), sizeof(chunk));
+        const char * stop = detail::scan_digits(q, end, 10, chunk);
+        q = stop;
+        if (stop != end) break;
+    }
+    unsigned rdx = 0;
+    if (q != p && q + 1 < last && q[0] == ':' && q[1] == ':'){
+        for (; p != q; ++p) rdx = std::min(rdx * 10 + static_cast<unsigned>(*p - '0'), unsigned(MAX_RADIX) + 1);
+        if (rdx < 2 || rdx > MAX_RADIX) return invalid;
+        p = q + 2;
+    }
+    else{
+        rdx = radix;
+    }
+    // the sign may also follow the radix prefix:
+    if (p != last && *p == '-'){
+        negative = true;
+        ++p;
+    }
+    if (rdx == radix){
+        // a number is there if a digit comes first or right after the radix point:
+        const auto value_at = [last](const char * c){
+            const unsigned char x = (c != last) ? static_cast<unsigned char>(*c) : 0x80;
+            return (x < 128) ? values[x] : -1;
+        };
+        const int v = value_at(p);
+        const bool starts = (v == -2) ? value_at(p + 1) >= 0 && value_at(p + 1) < radix : v >= 0 && v < radix;
+        if (!starts) return invalid;
+        p = value.read_packed(p, last);
+        value.isPositive = !negative || value.limbs.empty();
+        return from_chars_result{p, std::errc()};
+    }
+    std::string digit_values;
+    std::size_t whole_count;
+    p = number<radix>::read_digits(p, last, rdx, digit_values, whole_count);
+    if (digit_values.empty()) return invalid;
+    number<radix> result;
+    result.assign_other_radix(digit_values, whole_count, rdx);
+    result.isPositive = !negative || result.limbs.empty();
+    value.swap(result);
+    return from_chars_result{p, std::errc()};
+}
+
+template<unsigned char radix>
+/**
+ * @brief Formats a number without allocating memory
+ *
+ * Writes the same characters as number::str(), without a terminating null.
+ * @param first beginning of the output buffer
+ * @param last  end of the output buffer
+ * @param value number to format
+ * @return Pointer past the written characters and std::errc() on success,
+ * last and std::errc::value_too_large if the buffer is too small
+ */
+to_chars_result to_chars(char * first, char * last, const number<radix> & value){
+    const std::size_t total = value.digit_total();
+    if (static_cast<std::size_t>(last - first) < value.str_length(total)) return to_chars_result{last, std::errc::value_too_large};
+    return to_chars_result{value.write_str(first, total), std::errc()};
+}
+
+template<typename T, unsigned char radix>
+/**
+ * @brief Converts a number to a native arithmetic type without throwing
+ *
+ * Integers are truncated towards zero, the 128-bit types included.
+ * Floating point values are rounded to nearest, ties to even, from the
+ * leading digits alone whenever the remaining ones cannot change the result.
+ * @param value number to convert
+ * @param out   output, for integers left untouched on error, for floating
+ * point types set to the infinity of the sign on error
+ * @return std::errc() on success, std::errc::result_out_of_range if the
+ * value does not fit into T
+ */
+std::errc to_native(const number<radix> & value, T & out){
+    static_assert(detail::is_native_integer<T>::value || std::is_floating_point<T>::value,
+                  "fixedpoint::to_native converts to integer and floating point types");
+    return value.native_value(out, detail::is_native_integer<T>());
+}
+
+template<unsigned char radix>
+/**
+ * @brief Writes a number in a compact binary format
+ *
+ * The format, version detail::serial_version, is
+ * <ul>
+ *  <li>one byte of format version and one byte of radix</li>
+ *  <li>LEB128 of the fractional digit count shifted left by one, the lowest bit is the sign</li>
+ *  <li>LEB128 of the limb count</li>
+ *  <li>all limbs but the most significant one as 8 byte little endian words</li>
+ *  <li>LEB128 of the most significant limb, if there are any limbs</li>
+ * </ul>
+ * so the limbs of long numbers are copied as they are and short numbers
+ * take a few bytes. Values need no alignment and follow each other directly.
+ * @param first beginning of the output buffer
+ * @param last  end of the output buffer
+ * @param value number to write
+ * @return Pointer past the written bytes and std::errc() on success,
+ * last and std::errc::value_too_large if the buffer is too small
+ */
+to_chars_result serialize(char * first, char * last, const number<radix> & value){
+    if (static_cast<std::size_t>(last - first) < value.serialized_size()) return to_chars_result{last, std::errc::value_too_large};
+    const std::size_t n = value.limbs.size();
+    *first++ = static_cast<char>(detail::serial_version);
+    *first++ = static_cast<char>(radix);
+    first = detail::write_varint(first, (value.frac_digits << 1) | (value.isPositive ? 0 : 1));
+    first = detail::write_varint(first, n);
+    if (n != 0){
+        first = detail::store_limbs(first, value.limbs.data(), n - 1);
+        first = detail::write_varint(first, value.limbs.back());
+    }
+    return to_chars_result{first, std::errc()};
+}
+
+template<unsigned char radix>
+/**
+ * @brief Appends the binary format of a number to out
+ * @return Reference to out
+ */
+std::string & serialize(std::string & out, const number<radix> & value){
+    const std::size_t size = out.size();
+    out.resize(size + value.serialized_size());
+    serialize(&out[size], &out[0] + out.size(), value);
+    return out;
+}
+
+template<unsigned char radix>
+/**
+ * @brief Reads a number written by serialize
+ *
+ * Works on any byte range, e.g. a memory mapped file, the limbs are
+ * copied with a single memcpy on little endian machines.
+ * @param first beginning of the bytes
+ * @param last  end of the bytes
+ * @param value output, left untouched on error
+ * @return Pointer past the number and std::errc() on success, first and
+ * std::errc::invalid_argument if the bytes are truncated, malformed,
+ * of another format version or of another radix
+ */
+from_chars_result deserialize(const char * first, const char * last, number<radix> & value){
+    const from_chars_result invalid{first, std::errc::invalid_argument};
+    if (last - first < 2 || static_cast<unsigned char>(first[0]) != detail::serial_version ||
+            static_cast<unsigned char>(first[1]) != radix){
+        return invalid;
+    }
+    std::uint64_t frac, n, top = 0;
+    const char * p = detail::read_varint(first + 2, last, frac);
+    if (p == nullptr || (p = detail::read_varint(p, last, n)) == nullptr) return invalid;
+    const char * words = p;
+    if (n != 0){
+        // validate everything before value is touched:
+        if (n - 1 > static_cast<std::uint64_t>(last - p) / sizeof(detail::limb)) return invalid;
+        for (std::size_t i = 0; i + 1 < n; ++i){
+            detail::limb l;
+            detail::load_limbs(p + i * sizeof(detail::limb), &l, 1);
+            if (l >= detail::limb_arith<radix>::base) return invalid;
+        }
+        p = detail::read_varint(p + (n - 1) * sizeof(detail::limb), last, top);
+        if (p == nullptr || top >= detail::limb_arith<radix>::base) return invalid;
+    }
+    value.limbs.resize(n);
+    if (n != 0){
+        detail::load_limbs(words, value.limbs.data(), n - 1);
+        value.limbs[n - 1] = top;
+    }
+    value.frac_digits = frac >> 1;
+    value.isPositive = (frac & 1) == 0;
+    value.strip_zeroes();
+    return from_chars_result{p, std::errc()};
+}
+
+namespace detail{
+
+/**
+ * @brief Read only view of a file's bytes
+ *
+ * Maps the file into memory where FIXEDPOINT_MMAP is available,
+ * reads it into a buffer otherwise.
+ */
+class file_view{
+public:
+    /**
+     * @throw std::system_error if the file cannot be opened or read
+     */
+    explicit file_view(const std::string & path){
+#if defined(FIXEDPOINT_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw(std::system_error(errno, std::generic_category(), path));
+        struct stat info;
+        const bool failed = (::fstat(fd, &info) != 0);
+        if (failed || S_ISDIR(info.st_mode)){
+            const int error = failed ? errno : EISDIR;
+            ::close(fd);
+            throw(std::system_error(error, std::generic_category(), path));
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        if (size != 0){
+            void * address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED){
+                const int error = errno;
+                ::close(fd);
+                throw(std::system_error(error, std::generic_category(), path));
             }
-            else{ //it's a number or something in place of a number
-                postfixBuild.push_back(std::move(now));
+            ::madvise(address, size, MADV_WILLNEED);
+            mapped = static_cast<const char *>(address);
+        }
+        ::close(fd);
+#else
+        errno = 0;
+        std::ifstream in(path, std::ios::binary);
+        if (!in){
+            // streams don't tell the cause, errno of the failed open usually does
+            const int error = (errno != 0) ? errno : static_cast<int>(std::errc::io_error);
+            throw(std::system_error(error, std::generic_category(), path));
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        size = buffer.size();
+        if (in.bad()) throw(std::system_error(std::make_error_code(std::errc::io_error), path));
+#endif
+    }
+    file_view(const file_view &) = delete;
+    file_view & operator =(const file_view &) = delete;
+    ~file_view(){
+#if defined(FIXEDPOINT_MMAP)
+        if (mapped != nullptr) ::munmap(const_cast<char *>(mapped), size);
+#endif
+    }
+
+    const char * begin() const{
+        return (mapped != nullptr) ? mapped : buffer.data();
+    }
+    const char * end() const{
+        return begin() + size;
+    }
+
+private:
+    const char * mapped = nullptr;
+    std::string buffer;
+    std::size_t size = 0;
+};
+
+/**
+ * @brief Runs task(0) ... task(count-1), each on its own thread but the last one
+ *
+ * Exceptions of the tasks are rethrown once all of them finished.
+ * @throw std::system_error if a thread cannot be started, after the
+ * started ones finished
+ */
+template<typename Task>
+void run_parallel(std::size_t count, const Task & task){
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+    auto guarded = [&task, &errors](std::size_t i){
+        try{
+            task(i);
+        }
+        catch (...){
+            errors[i] = std::current_exception();
+        }
+    };
+    try{
+        for (std::size_t i = 0; i + 1 < count; ++i) threads.emplace_back(guarded, i);
+    }
+    catch (...){
+        // threads that could not be started are not run, the running ones must be joined
+        for (auto & t : threads) t.join();
+        throw;
+    }
+    if (count != 0) guarded(count - 1);
+    for (auto & t : threads) t.join();
+    for (const auto & e : errors){
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+} // namespace detail
+
+template<unsigned char radix>
+/**
+ * @brief Parses a buffer of numbers, one per line, in parallel
+ *
+ * Lines hold the format accepted by from_chars, surrounding spaces, tabs
+ * and a carriage return before the line feed are ignored. The buffer is
+ * split on line boundaries into up to threads chunks of at least
+ * FIXEDPOINT_LOAD_CHUNK bytes, lines are counted and then parsed
+ * directly into place by one thread per chunk.
+ * @param first beginning of the buffer, e.g. of a memory mapped file
+ * @param last  end of the buffer, a final line feed is optional
+ * @param out   numbers are appended, one per line, malformed lines as 0
+ * @param threads maximal number of threads, 0 for the hardware concurrency
+ * @return Malformed lines in ascending order, with std::errc::invalid_argument
+ */
+std::vector<line_error> parse_lines(const char * first, const char * last,
+                                    std::vector<number<radix>> & out, unsigned threads = 0){
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    const std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(threads, size / FIXEDPOINT_LOAD_CHUNK));
+    // chunk i is [bounds[i], bounds[i+1]), each but the last one ends with a line feed:
+    std::vector<const char *> bounds(chunks + 1, last);
+    bounds[0] = first;
+    for (std::size_t i = 1; i < chunks; ++i){
+        const char * from = std::max(bounds[i - 1], first + size / chunks * i);
+        const void * feed = std::memchr(from, '\n', static_cast<std::size_t>(last - from));
+        bounds[i] = (feed == nullptr) ? last : static_cast<const char *>(feed) + 1;
+    }
+    std::vector<std::size_t> lines(chunks + 1, 0);
+    detail::run_parallel(chunks, [&bounds, &lines](std::size_t i){
+        std::size_t count = 0;
+        const char * p = bounds[i];
+        while (p != bounds[i + 1]){
+            const void * feed = std::memchr(p, '\n', static_cast<std::size_t>(bounds[i + 1] - p));
+            p = (feed == nullptr) ? bounds[i + 1] : static_cast<const char *>(feed) + 1;
+            ++count;
+        }
+        lines[i + 1] = count;
+    });
+    for (std::size_t i = 0; i < chunks; ++i) lines[i + 1] += lines[i];
+    const std::size_t offset = out.size();
+    out.resize(offset + lines[chunks]);
+    std::vector<std::vector<line_error>> errors(chunks);
+    detail::run_parallel(chunks, [&bounds, &lines, &out, &errors, offset](std::size_t i){
+        const char * p = bounds[i];
+        for (std::size_t line = lines[i]; p != bounds[i + 1]; ++line){
+            const void * feed = std::memchr(p, '\n', static_cast<std::size_t>(bounds[i + 1] - p));
+            const char * end = (feed == nullptr) ? bounds[i + 1] : static_cast<const char *>(feed);
+            const char * next = (feed == nullptr) ? end : end + 1;
+            while (p != end && (*p == ' ' || *p == '\t')) ++p;
+            while (end != p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+            const from_chars_result r = from_chars(p, end, out[offset + line]);
+            if (r.ec != std::errc() || r.ptr != end){
+                out[offset + line] = number<radix>();
+                errors[i].push_back(line_error{line + 1, std::errc::invalid_argument});
             }
+            p = next;
         }
-        while(! operationStack.empty() ){
-            if (operationStack.back() == "(") throw(invalid_expression_format("mismatched left parethesis found"));
-            postfixBuild.push_back(std::move(operationStack.back()));
-            operationStack.pop_back();
+    });
+    std::vector<line_error> result;
+    for (const auto & e : errors) result.insert(result.end(), e.begin(), e.end());
+    return result;
+}
+
+template<unsigned char radix>
+/**
+ * @brief Loads a file of numbers, one per line
+ *
+ * Maps the file into memory (reads it if FIXEDPOINT_MMAP is not defined)
+ * and parses it by parse_lines.
+ * @param path  file to load
+ * @param out   numbers are appended, one per line, malformed lines as 0
+ * @param threads maximal number of threads, 0 for the hardware concurrency
+ * @return Malformed lines in ascending order
+ * @throw std::system_error if the file cannot be opened or read
+ */
+std::vector<line_error> load_lines(const std::string & path, std::vector<number<radix>> & out, unsigned threads = 0){
+    const detail::file_view file(path);
+    return parse_lines(file.begin(), file.end(), out, threads);
+}
+
+template<typename It>
+/**
+ * @brief Formats a range of numbers into one string
+ *
+ * Appends the str() representations of the numbers in [first, last) to out,
+ * separated by separator. The lengths are summed up front, so out grows
+ * at most once and every number is written in place.
+ * @param out       string to append to
+ * @param first     forward iterator to the first number
+ * @param last      end of the range
+ * @param separator characters written between two numbers
+ * @return Reference to out
+ */
+std::string & format_range(std::string & out, It first, It last, const std::string & separator){
+    std::size_t length = 0;
+    for (It it = first; it != last; ++it){
+        length += (it == first ? 0 : separator.size()) + it->str_length();
+    }
+    out.reserve(out.size() + length);
+    for (It it = first; it != last; ++it){
+        if (it != first) out += separator;
+        it->append_to(out);
+    }
+    return out;
+}
+
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+/**
+ * <b>The fixed_number struct represents fixedpoint numbers of bounded size</b>
+ * <p>
+ * It keeps WholeDigits whole and FracDigits fractional base-radix digits
+ * in an inline std::array of limbs, so no arithmetic operation allocates
+ * memory and the cost of every operation is bounded by the digit counts.
+ * <p>
+ * The scale is fixed at compile time: products and quotients are truncated
+ * to FracDigits fractional digits regardless of number::scale, and modulo
+ * truncates the quotient to an integer, like number with scale 0.
+ * Results with more than WholeDigits whole digits throw number_overflow.
+ * <p>
+ * Conversions from and to number<radix> are explicit, fractional digits
+ * beyond FracDigits are truncated when converting from number. String
+ * input and output goes through number.
+ * @code
+ * using price = fixedpoint::fixed_number<10, 12, 6>;
+ * price total = price("12.5") * 3; // 37.5
+ * @endcode
+ */
+struct fixed_number{
+    static_assert(radix<=MAX_RADIX, "fixedpoint::fixed_number's radix too high");
+    static_assert(radix>=2, "fixedpoint::fixed_number's radix is too low, use at least 2");
+    static_assert(WholeDigits + FracDigits > 0, "fixedpoint::fixed_number must have at least one digit");
+
+    /**
+     * @brief Number of whole digits
+     */
+    static constexpr std::size_t whole_digits = WholeDigits;
+
+    /**
+     * @brief Number of fractional digits, the scale of all results
+     */
+    static constexpr std::size_t frac_digits = FracDigits;
+
+    /**
+     * @brief Default constructor
+     *
+     * Constructs a number of zero value.
+     */
+    fixed_number() noexcept:
+        limbs{},
+        isPositive(true)
+    {}
+
+    /**
+     * @brief Integral type constructor
+     * @param x value to construct number with
+     * @throw number_overflow if x has more than WholeDigits digits
+     */
+    template<typename T, typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
+    fixed_number(T x):
+        limbs{},
+        isPositive(x>=0)
+    {
+        // magnitude, computed in unsigned arithmetic so that minimal values don't overflow
+        unsigned long long mag = static_cast<unsigned long long>(x);
+        if (!isPositive) mag = 0ull - mag;
+        std::array<limb, size + 3> wide{};
+        const std::size_t offset = FracDigits / arith::digits;
+        if (offset < size){
+            wide[offset] = mag % arith::base;
+            wide[offset + 1] = mag / arith::base;
+            wide[offset + 2] = arith::mul_pow(wide.data() + offset, wide.data() + offset,
+                                              2, FracDigits % arith::digits);
         }
-        for(auto it = postfixBuild.begin(); it!=postfixBuild.end(); ++it){
-            postfix.append(*it);
-            postfix.push_back(' ');
+        else if (mag != 0){
+            throw number_overflow();
         }
-        postfix.pop_back(); // remove last ' '
-        std::clog << "Built postfix expression: \"" << postfix << '"' << std::endl;
-        number<radix> retVal(eval_postfix(postfix));
-        return retVal;
+        store(wide.data(), wide.size());
     }
 
-    template<unsigned char oradix>
     /**
-     * @brief Converts numbers between radices
-     * @return Converted number
+     * @brief String constructor
+     *
+     * Accepts the same formats as the string constructor of number.
+     * @param src string to parse
+     * @throw number_overflow if the value has more than WholeDigits whole digits
+     * @throw (whatever the string constructor of number might throw)
      */
-    static number convert(const number<oradix> & other){
-        number result(other.str());
-        return result;
+    explicit fixed_number(const std::string & src):
+        fixed_number(number<radix>(src))
+    {}
+
+    /**
+     * @brief Conversion from number, truncates extra fractional digits
+     * @param src number to convert
+     * @throw number_overflow if src has more than WholeDigits whole digits
+     */
+    explicit fixed_number(const number<radix> & src):
+        limbs{},
+        isPositive(src.isPositive)
+    {
+        detail::limb_vector mag(src.limbs);
+        if (src.frac_digits < FracDigits) number<radix>::scale_up(mag, FracDigits - src.frac_digits);
+        else number<radix>::scale_down(mag, src.frac_digits - FracDigits);
+        store(mag.data(), mag.size());
     }
 
     /**
-     * @brief Swaps number with other
-     * @param other number to swap with
+     * @brief Conversion to number
      */
-    void swap( number& other ){
-        cela_cast.swap(other.cela_cast);
-        des_cast.swap(other.des_cast);
-        std::swap(isPositive, other.isPositive);
+    explicit operator number<radix>() const{
+        number<radix> result;
+        result.limbs.assign(limbs.begin(), limbs.end());
+        result.frac_digits = FracDigits;
+        result.isPositive = isPositive;
+        result.strip_zeroes();
+        return result;
     }
 
-private:
-    std::string cela_cast; // BIG_ENDIAN element ordering
-    std::string des_cast;  // LITTLE_ENDIAN element ordering
-    bool isPositive;
+    fixed_number & operator +=(const fixed_number & other){
+        add(other, false);
+        return *this;
+    }
+
+    fixed_number & operator -=(const fixed_number & other){
+        add(other, true);
+        return *this;
+    }
+
+    fixed_number & operator *=(const fixed_number & other){
+        const std::size_t an = used(limbs), bn = used(other.limbs);
+        isPositive = (isPositive == other.isPositive);
+        if (an == 0 || bn == 0){
+            limbs.fill(0);
+            isPositive = true;
+            return *this;
+        }
+        std::array<limb, 2 * size> product{};
+        if (&other == this) arith::sqr_basecase(product.data(), limbs.data(), an);
+        else arith::mul_basecase(product.data(), limbs.data(), an, other.limbs.data(), bn);
+        // drop the extra FracDigits fractional digits:
+        const std::size_t dropped = FracDigits / arith::digits;
+        if (an + bn <= dropped){
+            limbs.fill(0);
+            isPositive = true;
+            return *this;
+        }
+        if (FracDigits % arith::digits != 0){
+            arith::divrem_pow(product.data() + dropped, product.data() + dropped,
+                              an + bn - dropped, FracDigits % arith::digits);
+        }
+        store(product.data() + dropped, an + bn - dropped);
+        return *this;
+    }
 
     /**
-     * @brief Compares two numbers whithout taking sign into account
-     * @param other number to compare with
-     * @return 0 if equal, n<0 if *this<other, n>0 if *this>other
+     * @brief Divides number, the quotient is truncated to FracDigits fractional digits
+     * @param other divisor
+     * @return Reference to *this
+     * @throw division_by_zero if divisor is zero
+     * @throw number_overflow if the quotient has more than WholeDigits whole digits
      */
-    int cmp_ignore_sig(const number &other) const{
-        //přeskočení případných nul na začátku
-        size_t pos = cela_cast.find_last_not_of('0');
-        size_t other_pos = other.cela_cast.find_last_not_of('0');
-        if(cela_cast.npos == pos) pos=0;
-        if(other.cela_cast.npos == other_pos) other_pos=0;
-        if(pos != other_pos){
-            return (pos > other_pos) ? 1 : -1;
-        }else{
-            while(pos > 0){
-                if(values[static_cast<int>(cela_cast[pos])] != values[static_cast<int>(other.cela_cast[pos])]){
-                    return (values[static_cast<int>(cela_cast[pos])] > values[static_cast<int>(other.cela_cast[pos])]) ? 1 : -1;
-                }
-                pos--;
-            }
-            //porovnání nultých prvků celých částí
-            if(values[static_cast<int>(cela_cast[pos])] != values[static_cast<int>(other.cela_cast[pos])]){
-                return (values[static_cast<int>(cela_cast[pos])] > values[static_cast<int>(other.cela_cast[pos])]) ? 1 : -1;
-            }
-            //cela cast je stejna, rozhodne desetina cast
-            size_t limit = (des_cast.size() < other.des_cast.size()) ? des_cast.size() : other.des_cast.size();
-            while(pos < limit){
-                if(values[static_cast<int>(des_cast[pos])] != values[static_cast<int>(other.des_cast[pos])]){
-                    return (values[static_cast<int>(des_cast[pos])] > values[static_cast<int>(other.des_cast[pos])]) ? 1 : -1;
-                }
-                pos++;
-            }
-            //porovnání proti implicitním nulám
-            if(other.des_cast.size() > limit){
-                for (;pos < other.des_cast.size();pos++) {
-                    if (values[static_cast<int>(other.des_cast[pos])] > 0) return -1;
-                }
-            }
-            if(des_cast.size() > limit){
-                for (;pos < des_cast.size();pos++) {
-                    if (values[static_cast<int>(des_cast[pos])] > 0) return 1;
-                }
-            }
-            return 0;
+    fixed_number & operator /=(const fixed_number & other){
+        const std::size_t bn = used(other.limbs);
+        if (bn == 0) throw division_by_zero();
+        // this * radix^FracDigits / other:
+        std::array<limb, dividend_size> dividend{};
+        const std::size_t offset = FracDigits / arith::digits;
+        std::copy(limbs.begin(), limbs.end(), dividend.begin() + offset);
+        dividend[offset + size] = arith::mul_pow(dividend.data() + offset, dividend.data() + offset,
+                                                 size, FracDigits % arith::digits);
+        isPositive = (isPositive == other.isPositive);
+        const std::size_t an = used(dividend);
+        std::array<limb, dividend_size> quotient{};
+        if (an >= bn){
+            std::array<limb, size> remainder;
+            std::array<limb, dividend_size + size + 1> scratch;
+            arith::divrem(quotient.data(), remainder.data(), dividend.data(), an,
+                          other.limbs.data(), bn, scratch.data());
         }
+        store(quotient.data(), quotient.size());
+        return *this;
     }
 
     /**
-     * @brief Rise this number to the power of positive integer exponent
-     * @param exponent nubmer representing positive integer value
+     * @brief Computes modulo of number, the quotient is truncated to an integer
+     * @param other divisor
+     * @return Reference to *this
+     * @throw division_by_zero if divisor is zero
      */
-    void int_pow(number && exponent){
-        number nula(0);
-        number orig(*this);
-        //naivní algoritmus
-        while(exponent > nula){
-            operator*=(orig);
-            --exponent;
+    fixed_number & operator %=(const fixed_number & other){
+        const std::size_t an = used(limbs), bn = used(other.limbs);
+        if (bn == 0) throw division_by_zero();
+        if (an >= bn){
+            std::array<limb, size> quotient, remainder{};
+            std::array<limb, 2 * size + 1> scratch;
+            arith::divrem(quotient.data(), remainder.data(), limbs.data(), an,
+                          other.limbs.data(), bn, scratch.data());
+            limbs = remainder;
         }
+        if (used(limbs) == 0) isPositive = true;
+        return *this;
+    }
+
+    fixed_number & operator ++(){
+        return operator+=(fixed_number(1));
+    }
+    fixed_number & operator --(){
+        return operator-=(fixed_number(1));
+    }
+    fixed_number operator ++(int){
+        fixed_number copy(*this);
+        operator++();
+        return copy;
+    }
+    fixed_number operator --(int){
+        fixed_number copy(*this);
+        operator--();
+        return copy;
+    }
+
+    bool operator <(const fixed_number & rhs) const{
+        if (rhs.isPositive && !isPositive) return true;
+        if (isPositive && ! rhs.isPositive) return false;
+        int cmp = arith::cmp_n(limbs.data(), rhs.limbs.data(), size);
+        return isPositive ? cmp < 0 : cmp > 0;
+    }
+
+    bool operator ==(const fixed_number & rhs) const{
+        return isPositive == rhs.isPositive && limbs == rhs.limbs;
     }
 
     /**
-     * @brief Divides this by other and returns either the result of division or modulo based on the div parameter
-     * @param other number to divide this by
-     * @param div whether division, or modulo shall be returned
-     * @return Result of division if div is true and result of modulo otherwise
+     * @brief Calculates exponent-th power of number
+     * @param exponent which power to calculate, negative powers are
+     * computed from the reciprocal
+     * @return Reference to *this
+     * @throw unsupported_operation when attemted to power with fractional number
      */
-    number& div_or_mod(const number other,bool div){
-        std::string result;
-        number divisor;
-        number dividend;
+    fixed_number & pow(const fixed_number & exponent){
+        fixed_number whole(exponent);
+        if (!(whole.trunc() == exponent)){
+            throw unsupported_operation("Only integer exponent is suported for power function!");
+        }
+        if (!exponent.isPositive) operator=(fixed_number(1) /= *this);
+        // integer magnitude of the exponent, halved in each pass:
+        std::array<limb, size> e = whole.limbs;
+        const std::size_t offset = FracDigits / arith::digits;
+        std::copy(e.begin() + offset, e.end(), e.begin());
+        std::fill(e.end() - offset, e.end(), 0);
+        arith::divrem_pow(e.data(), e.data(), size, FracDigits % arith::digits);
+        fixed_number result(1);
+        while (used(e) != 0){
+            if (arith::divrem_1(e.data(), e.data(), size, 2) != 0) result *= *this;
+            if (used(e) != 0) operator*=(*this);
+        }
+        return operator=(result);
+    }
 
-        //dostatečný posun abych obsáhl všechna desetiná čísla, plus nová des. čísla zbytku v případě nenulového scale
-        dividend.des_cast.assign(cela_cast.rbegin(), cela_cast.rend());
-        dividend.des_cast.append(des_cast);
+    /**
+     * @brief Floors the number
+     * @return Reference to *this
+     */
+    fixed_number & floor(){
+        if (drop_fraction() && !isPositive) operator-=(fixed_number(1));
+        if (used(limbs) == 0) isPositive = true;
+        return *this;
+    }
 
-        divisor.des_cast.assign(other.cela_cast.rbegin(), other.cela_cast.rend());
-        size_t shift = 0;
-        if(divisor == 0){
-            shift = other.des_cast.find_last_not_of(digits[0]);
+    /**
+     * @brief Ceils the number
+     * @return Reference to *this
+     */
+    fixed_number & ceil(){
+        if (drop_fraction() && isPositive) operator+=(fixed_number(1));
+        if (used(limbs) == 0) isPositive = true;
+        return *this;
+    }
 
-            if (std::string::npos == shift) throw division_by_zero();
+    /**
+     * @brief Truncates the number
+     * @return Reference to *this
+     */
+    fixed_number & trunc(){
+        drop_fraction();
+        if (used(limbs) == 0) isPositive = true;
+        return *this;
+    }
 
-            divisor.des_cast.assign(other.des_cast.substr(shift));
-            //upřímě netuším proč shift++, ale jinak to vrací výsledek o řád menší než by měl být
-            shift++;
-        }else{
-            divisor.des_cast.append(other.des_cast);
-        }
+    /**
+     * @brief Returns string representation of the object
+     *
+     * The format is the same as that of number::str().
+     * @return A newly constructed string
+     */
+    std::string str() const{
+        return static_cast<number<radix>>(*this).str();
+    }
 
-        size_t dividend_size = cela_cast.size();
-        long long deviation = dividend_size - other.cela_cast.size();
+private:
+    typedef detail::limb limb;
+    typedef detail::limb_arith<radix> arith;
 
-        //počet kroků dělení
-        int steps = deviation + scale + shift;
+    // limbs needed for WholeDigits+FracDigits digits
+    static constexpr std::size_t size = (WholeDigits + FracDigits + arith::digits - 1) / arith::digits;
+    // exclusive bound of the most significant limb
+    static constexpr limb top_bound = detail::limb_pow(radix, WholeDigits + FracDigits - (size - 1) * arith::digits);
+    // limbs of a dividend scaled by radix^FracDigits
+    static constexpr std::size_t dividend_size = size + FracDigits / arith::digits + 1;
 
-        if (steps < 0){//dělitel je řádově větší, takže celé tohle číso je zbytek
-            if(div) *this = 0;
-            return *this;
-        }
+    std::array<limb, size> limbs; // magnitude scaled by radix^FracDigits, LITTLE_ENDIAN limbs
+    bool isPositive;
 
-        for(int i = 0; i <= steps;i++){
-            size_t tmp=0;
-            while(dividend.cmp_ignore_sig(divisor) >= 0){
-                tmp++;
-                dividend -= divisor;
-            }
-            result.push_back(digits[tmp]);
-            divisor.des_cast.insert(0, 1, digits[0]);
-        }
-        if(div){
-            int move = result.size() - scale;
-            if(move>0){
-                cela_cast.assign(result.rbegin()+scale,result.rend());
-                des_cast.clear();
-                des_cast.append(result,move, std::string::npos);
-            }else{
-                des_cast.append(-move,digits[0]);
-                des_cast.append(result);
-            }
+    /**
+     * @brief Number of limbs without the most significant zero limbs
+     */
+    template<std::size_t n>
+    static std::size_t used(const std::array<limb, n> & x){
+        std::size_t count = n;
+        while (count > 0 && x[count - 1] == 0) --count;
+        return count;
+    }
 
-            isPositive = (isPositive == other.isPositive);
-        }else{
-            std::string tmp= dividend.des_cast.substr(0,cela_cast.size());
-            std::reverse(tmp.begin(),tmp.end());
-            cela_cast = std::move(tmp);
-            des_cast = dividend.des_cast.substr(cela_cast.size());
-            scale = 0;
+    /**
+     * @brief Stores a magnitude of n limbs, checking that it fits
+     * @throw number_overflow if it has more than WholeDigits+FracDigits digits
+     */
+    void store(const limb * mag, std::size_t n){
+        for (std::size_t i = size; i < n; ++i){
+            if (mag[i] != 0) throw number_overflow();
         }
-        strip_zeroes();
-        return *this;
+        if (n >= size && mag[size - 1] >= top_bound) throw number_overflow();
+        limbs.fill(0);
+        std::copy(mag, mag + std::min(n, size), limbs.begin());
+        if (used(limbs) == 0) isPositive = true;
     }
 
     /**
-     * @brief Strip leading and trailing 0
-     *
-     * If value of whole part is equal to 0, then strips all but the last
-     * leading 0 digit, otherwise strips all leading zeroes.
-     *
-     * Always truncates any trailing zeroes.
-     *
-     * If only one digit stays, that is a singular 0 in cela_cast,
-     * also sets isPositive to true, so we are consistent with sign of zero.
+     * @brief Adds other, or subtracts it if subtract is set
      */
-    void strip_zeroes(){
-        std::size_t pos;
-        bool isZero;
-        if((pos=cela_cast.find_last_not_of(digits[0])) != cela_cast.npos){
-            cela_cast.resize(pos+1,digits[0]);
-            isZero = false;
+    void add(const fixed_number & other, bool subtract){
+        if (isPositive == (other.isPositive != subtract)){
+            std::array<limb, size + 1> sum;
+            sum[size] = arith::add_n(sum.data(), limbs.data(), other.limbs.data(), size);
+            store(sum.data(), sum.size());
+        }
+        else if (arith::cmp_n(limbs.data(), other.limbs.data(), size) >= 0){
+            arith::sub_n(limbs.data(), limbs.data(), other.limbs.data(), size);
+            if (used(limbs) == 0) isPositive = true;
         }
         else{
-            cela_cast.resize(1,digits[0]);
-            isZero = true;
-        }
-        // leading zeroes stripped
-        if ((pos=des_cast.find_last_not_of(digits[0])) == des_cast.npos){
-            des_cast.clear();
-            // isZero stays as is true && isZero always evals as true
-        }
-        else {
-            des_cast.resize(pos+1,digits[0]);
-            isZero = false; // false && isZero always evals as false
-        }
-        if (isZero) isPositive = true; // 0 is treated as positive
-        // trailing zeroes truncated
-    }
-
-    /**
-     * @brief Converts strings of whole and decimal parts
-     * <p>
-     * Conversion of string a to string b is achieved by utilizing
-     * the muladd_vector_uint_uint method for the whole part.
-     * For the whole part this method merely handles
-     * digit -> value and value -> digit conversion and related tasks.
-     * For the decimal part this function also performs minor tasks related to
-     * conversion
-     * <p>
-     * @param srcWhole   Source string to convert - whole part as BIG ENDIAN
-     * @param srcDec     Source string to convert - decimal part as LITTLE ENDIAN
-     * @param rdx   Number base (radix) of source string
-     * @param scale Number of decimal places to compute
-     * @return  Pair of holding converted number representation
-     */
-    static std::pair<std::string, std::string> convert_with_vector(
-            const std::string & srcWhole,
-            const std::string & srcDec,
-            unsigned int rdx,
-            unsigned int scale){
-        std::vector<unsigned int> vec;
-        for(auto x=srcWhole.crbegin(); x!=srcWhole.crend();++x){
-            muladd_vector_uint_uint(vec,rdx,values[static_cast<int>(*x)]);
-        }
-        std::string retValWhole;
-        for (auto x : vec){
-            retValWhole.push_back(digits[x]);
-        }
-        std::string retValDec;
-        vec.clear();
-        for(auto x=srcDec.crbegin(); x!=srcDec.crend();++x){
-            vec.push_back(values[static_cast<int>(*x)]);
-        }
-        std::size_t orig_size = vec.size();
-        unsigned int digitConverter = 0;
-        for(std::size_t i=0;i<scale;++i){
-            muladd_vector_uint_uint(vec,radix,0,rdx);
-            digitConverter = 0;
-            while(vec.size() > orig_size){
-                // does what muladd_vector_uint_uint does, but on small scale
-                digitConverter *=rdx;
-                digitConverter += vec.back();
-                vec.pop_back();
-            }
-            retValDec.push_back(digits[digitConverter]);
-        }
-        return make_pair(retValWhole, retValDec);
-    }
-
-    /**
-     * @brief Multiplies vector by uint, then adds another uint
-     *
-     * Multiplies a vectors elements by an unsigned integer and then adds
-     * another unsigned integer. Elements stored in vector are kept at values
-     * smaller than specified in max_element - which is equivalent to storing
-     * the results in "base-max_element". Vector should store values as big endian.
-     * @param vec   Vector to multiply
-     * @param mul   Vector's multiplier
-     * @param max_element First value larger than allowed in vector's cells
-     * @param add   The number to add to the vector
-     */
-    static void muladd_vector_uint_uint(
-            std::vector<unsigned int> & vec,
-            unsigned int mul,
-            unsigned int add,
-            unsigned int max_element = radix){
-        unsigned int carry = 0;
-        // multiply:
-        for(auto x = vec.begin(); x != vec.end(); ++x){
-            carry += (*x)*mul;
-            *x = carry % max_element; // lower half
-            carry /= max_element; // upper half
-        }
-        while (carry!=0) {
-            vec.push_back(carry % max_element);
-            carry /= max_element;
-        }
-        // add:
-        carry = add;
-        for (auto x = vec.begin(); x != vec.end(); ++x){
-            carry += *x;
-            *x = carry % max_element;
-            carry /= max_element;
-        }
-        while (carry!=0) {
-            vec.push_back(carry % max_element);
-            carry /= max_element;
+            arith::sub_n(limbs.data(), other.limbs.data(), limbs.data(), size);
+            isPositive = !isPositive;
         }
     }
 
+    /**
+     * @brief Zeroes all fractional digits, keeps the sign even if the result is zero
+     * @return Whether any of them was nonzero
+     */
+    bool drop_fraction(){
+        bool nonzero = false;
+        const std::size_t offset = std::min(FracDigits / arith::digits, size);
+        for (std::size_t i = 0; i < offset; ++i){
+            nonzero = nonzero || limbs[i] != 0;
+            limbs[i] = 0;
+        }
+        if (offset < size && FracDigits % arith::digits != 0){
+            limb part = limbs[offset] % arith::power(FracDigits % arith::digits);
+            nonzero = nonzero || part != 0;
+            limbs[offset] -= part;
+        }
+        return nonzero;
+    }
 };
 
-template<unsigned char radix>
-bool operator <=(const number<radix>& lhs,const number<radix> & rhs){
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+constexpr std::size_t fixed_number<radix, WholeDigits, FracDigits>::whole_digits;
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+constexpr std::size_t fixed_number<radix, WholeDigits, FracDigits>::frac_digits;
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+constexpr std::size_t fixed_number<radix, WholeDigits, FracDigits>::size;
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+constexpr detail::limb fixed_number<radix, WholeDigits, FracDigits>::top_bound;
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+constexpr std::size_t fixed_number<radix, WholeDigits, FracDigits>::dividend_size;
+
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+bool operator <=(const fixed_number<radix, WholeDigits, FracDigits> & lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
     return ( ! ( rhs < lhs ) );
 }
 
-template<unsigned char radix>
-bool operator !=(const number<radix>& lhs,const number<radix> & rhs){
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+bool operator !=(const fixed_number<radix, WholeDigits, FracDigits> & lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
     return ( ! ( lhs == rhs ) );
 }
 
-template<unsigned char radix>
-bool operator >(const number<radix>& lhs,const number<radix> & rhs){
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+bool operator >(const fixed_number<radix, WholeDigits, FracDigits> & lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
     return ( rhs < lhs );
 }
 
-template<unsigned char radix>
-bool operator >=(const number<radix>& lhs,const number<radix> & rhs){
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+bool operator >=(const fixed_number<radix, WholeDigits, FracDigits> & lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
     return ( ! ( lhs < rhs ) );
 }
 
-template<unsigned char radix>
-number<radix> operator +(const number<radix> & lhs,
-                         const number<radix> & rhs){
-    number<radix> newnum(lhs);
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixed_number<radix, WholeDigits, FracDigits> operator +(const fixed_number<radix, WholeDigits, FracDigits> & lhs,
+                   const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum+=rhs;
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator +(const number<radix> & lhs, T rhs){
-    number<radix> newnum(lhs);
-    newnum+=number<radix>(rhs);
+fixed_number<radix, WholeDigits, FracDigits> operator +(const fixed_number<radix, WholeDigits, FracDigits> & lhs, T rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
+    newnum+=fixed_number<radix, WholeDigits, FracDigits>(rhs);
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator +(T lhs, const number<radix> & rhs){
-    number<radix> newnum(lhs);
+fixed_number<radix, WholeDigits, FracDigits> operator +(T lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum+=rhs;
     return newnum;
 }
 
-template<unsigned char radix>
-number<radix> operator -(const number<radix> & lhs,
-                         const number<radix> & rhs){
-    number<radix> newnum(lhs);
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixed_number<radix, WholeDigits, FracDigits> operator -(const fixed_number<radix, WholeDigits, FracDigits> & lhs,
+                   const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum-=rhs;
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator -(const number<radix> & lhs, T rhs){
-    number<radix> newnum(lhs);
-    newnum-=number<radix>(rhs);
+fixed_number<radix, WholeDigits, FracDigits> operator -(const fixed_number<radix, WholeDigits, FracDigits> & lhs, T rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
+    newnum-=fixed_number<radix, WholeDigits, FracDigits>(rhs);
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator -(T lhs, const number<radix> & rhs){
-    number<radix> newnum(lhs);
+fixed_number<radix, WholeDigits, FracDigits> operator -(T lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum-=rhs;
     return newnum;
 }
 
-template<unsigned char radix>
-number<radix> operator *(const number<radix> & lhs,
-                         const number<radix> & rhs){
-    number<radix> newnum(lhs);
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixed_number<radix, WholeDigits, FracDigits> operator *(const fixed_number<radix, WholeDigits, FracDigits> & lhs,
+                   const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum*=rhs;
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator *(const number<radix> & lhs, T rhs){
-    number<radix> newnum(lhs);
-    newnum*=number<radix>(rhs);
+fixed_number<radix, WholeDigits, FracDigits> operator *(const fixed_number<radix, WholeDigits, FracDigits> & lhs, T rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
+    newnum*=fixed_number<radix, WholeDigits, FracDigits>(rhs);
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator *(T lhs, const number<radix> & rhs){
-    number<radix> newnum(lhs);
+fixed_number<radix, WholeDigits, FracDigits> operator *(T lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum*=rhs;
     return newnum;
 }
 
-template<unsigned char radix>
-number<radix> operator /(const number<radix> & lhs,
-                         const number<radix> & rhs){
-    number<radix> newnum(lhs);
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixed_number<radix, WholeDigits, FracDigits> operator /(const fixed_number<radix, WholeDigits, FracDigits> & lhs,
+                   const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum/=rhs;
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator /(const number<radix> & lhs, T rhs){
-    number<radix> newnum(lhs);
-    newnum/=number<radix>(rhs);
+fixed_number<radix, WholeDigits, FracDigits> operator /(const fixed_number<radix, WholeDigits, FracDigits> & lhs, T rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
+    newnum/=fixed_number<radix, WholeDigits, FracDigits>(rhs);
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator /(T lhs, const number<radix> & rhs){
-    number<radix> newnum(lhs);
+fixed_number<radix, WholeDigits, FracDigits> operator /(T lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum/=rhs;
     return newnum;
 }
 
-template<unsigned char radix>
-number<radix> operator %(const number<radix> & lhs,
-                         const number<radix> & rhs){
-    number<radix> newnum(lhs);
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixed_number<radix, WholeDigits, FracDigits> operator %(const fixed_number<radix, WholeDigits, FracDigits> & lhs,
+                   const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum%=rhs;
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator %(const number<radix> & lhs, T rhs){
-    number<radix> newnum(lhs);
-    newnum%=number<radix>(rhs);
+fixed_number<radix, WholeDigits, FracDigits> operator %(const fixed_number<radix, WholeDigits, FracDigits> & lhs, T rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
+    newnum%=fixed_number<radix, WholeDigits, FracDigits>(rhs);
     return newnum;
 }
-template<unsigned char radix,
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits,
          typename T,
          typename = decltype(static_cast<std::true_type>(std::is_integral<T>()))>
-number<radix> operator %(T lhs, const number<radix> & rhs){
-    number<radix> newnum(lhs);
+fixed_number<radix, WholeDigits, FracDigits> operator %(T lhs, const fixed_number<radix, WholeDigits, FracDigits> & rhs){
+    fixed_number<radix, WholeDigits, FracDigits> newnum(lhs);
     newnum%=rhs;
     return newnum;
 }
 
-template<unsigned char radix>
-std::ostream& operator<<(std::ostream& out, const number<radix> & ref){
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+std::ostream& operator<<(std::ostream& out, const fixed_number<radix, WholeDigits, FracDigits> & ref){
     out << ref.str();
     return out;
 }
 
-template<unsigned char radix>
-std::istream& operator>>(std::istream& in, number<radix> & ref){
-    std::string temp;
-    in >> temp;
-    ref = number<radix>(temp);
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+std::istream& operator>>(std::istream& in, fixed_number<radix, WholeDigits, FracDigits> & ref){
+    number<radix> temp;
+    if (in >> temp){
+        // too many whole digits fail like malformed input
+        try{
+            ref = fixed_number<radix, WholeDigits, FracDigits>(temp);
+        }
+        catch (const number_overflow &){
+            in.setstate(std::ios_base::failbit);
+        }
+    }
     return in;
 }
 
+template<unsigned char radix>
+/**
+ * <b>The number_vector struct is a column of numbers in one arena</b>
+ * <p>
+ * The limbs of all values are stored back to back in a single buffer,
+ * value i occupying the limbs [offsets[i], offsets[i+1]), while the signs
+ * and numbers of fractional digits are kept in arrays of their own.
+ * Scans like sum, min, max and compare walk contiguous memory instead of
+ * following a separate allocation of every number.
+ * <p>
+ * Values are appended from number<radix> and read back as number<radix>.
+ * Elementwise addition and multiplication give the same results as the
+ * operators of number, the scale of products follows number::operator*=.
+ * @code
+ * fixedpoint::number_vector<10> column;
+ * column.push_back(fixedpoint::decimal("12.5"));
+ * column.push_back(fixedpoint::decimal("-2.25"));
+ * fixedpoint::decimal total = column.sum(); // 10.25
+ * @endcode
+ */
+struct number_vector{
+    /**
+     * @brief Default constructor
+     *
+     * Constructs an empty column.
+     */
+    number_vector():
+        offsets(1, 0)
+    {}
+
+    template<typename It>
+    /**
+     * @brief Constructs a column of the numbers in [first, last)
+     */
+    number_vector(It first, It last):
+        number_vector()
+    {
+        for (; first != last; ++first) push_back(*first);
+    }
+
+    /**
+     * @brief Number of values
+     */
+    std::size_t size() const noexcept { return negative.size(); }
+
+    /**
+     * @brief Whether there are no values
+     */
+    bool empty() const noexcept { return negative.empty(); }
+
+    /**
+     * @brief Reserves room for count values of limb_count limbs in total
+     */
+    void reserve(std::size_t count, std::size_t limb_count = 0){
+        arena.reserve(limb_count);
+        offsets.reserve(count + 1);
+        negative.reserve(count);
+        scales.reserve(count);
+    }
+
+    /**
+     * @brief Removes all values, keeping the allocated storage
+     */
+    void clear() noexcept{
+        arena.clear();
+        offsets.resize(1);
+        negative.clear();
+        scales.clear();
+    }
+
+    /**
+     * @brief Swaps the column with other
+     * @param other column to swap with
+     */
+    void swap(number_vector & other) noexcept{
+        arena.swap(other.arena);
+        offsets.swap(other.offsets);
+        negative.swap(other.negative);
+        scales.swap(other.scales);
+    }
+
+    /**
+     * @brief Appends a copy of x
+     */
+    void push_back(const number<radix> & x){
+        arena.insert(arena.end(), x.limbs.begin(), x.limbs.end());
+        offsets.push_back(arena.size());
+        negative.push_back(!x.isPositive);
+        scales.push_back(x.frac_digits);
+    }
+
+    /**
+     * @brief Value i as a number
+     */
+    number<radix> operator [](std::size_t i) const{
+        number<radix> result;
+        get(i, result);
+        return result;
+    }
+
+    /**
+     * @brief Assigns value i to out, reusing the storage of out
+     */
+    void get(std::size_t i, number<radix> & out) const{
+        out.limbs.assign(arena.begin() + offsets[i], arena.begin() + offsets[i + 1]);
+        out.frac_digits = scales[i];
+        out.isPositive = !negative[i];
+    }
+
+    /**
+     * @brief Compares values i and j
+     * @return 0 if equal, n<0 if value i is less, n>0 if it is greater
+     */
+    int compare(std::size_t i, std::size_t j) const{
+        if (negative[i] != negative[j]) return negative[i] ? -1 : 1;
+        const int result = cmp_mag(i, j);
+        return negative[i] ? -result : result;
+    }
+
+    /**
+     * @brief Sum of all values, zero for an empty column
+     *
+     * Positive and negative values are accumulated separately at the
+     * largest scale of the column, each value is added by a single pass
+     * over its limbs. The two totals are subtracted once at the end.
+     */
+    number<radix> sum() const{
+        std::size_t frac = 0;
+        for (std::size_t f : scales) frac = std::max(frac, f);
+        limb_vector totals[2]; // positive and negative values
+        for (std::size_t i = 0; i < size(); ++i){
+            const limb * a = arena.data() + offsets[i];
+            const std::size_t n = offsets[i + 1] - offsets[i];
+            if (n == 0) continue;
+            const std::size_t shift = frac - scales[i];
+            const std::size_t at = shift / arith::digits;
+            limb_vector & total = totals[negative[i]];
+            if (total.size() < at + n + 1) total.resize(at + n + 1, 0);
+            limb * r = total.data() + at;
+            const std::size_t rn = total.size() - at;
+            limb carry;
+            if (shift % arith::digits == 0){
+                carry = arith::add(r, r, rn, a, n);
+            }
+            else{
+                carry = arith::addmul_1(r, a, n, arith::power(shift % arith::digits));
+                carry = arith::add_1(r + n, r + n, rn - n, carry);
+            }
+            if (carry != 0) total.push_back(carry);
+        }
+        number<radix> result, subtrahend;
+        result.limbs.swap(totals[0]);
+        subtrahend.limbs.swap(totals[1]);
+        result.frac_digits = subtrahend.frac_digits = frac;
+        result.strip_zeroes();
+        subtrahend.strip_zeroes();
+        return result -= subtrahend;
+    }
+
+    /**
+     * @brief Index of the first smallest value
+     * @throw unsupported_operation if the column is empty
+     */
+    std::size_t min_index() const{
+        return extreme_index(-1);
+    }
+
+    /**
+     * @brief Index of the first largest value
+     * @throw unsupported_operation if the column is empty
+     */
+    std::size_t max_index() const{
+        return extreme_index(1);
+    }
+
+    /**
+     * @brief Smallest value
+     * @throw unsupported_operation if the column is empty
+     */
+    number<radix> min() const{
+        return (*this)[min_index()];
+    }
+
+    /**
+     * @brief Largest value
+     * @throw unsupported_operation if the column is empty
+     */
+    number<radix> max() const{
+        return (*this)[max_index()];
+    }
+
+    /**
+     * @brief Adds the values of other elementwise
+     *
+     * The value of the smaller scale is scaled up as in number::operator+=,
+     * then the magnitudes are added or subtracted limb by limb. Results
+     * are written back over the arena while they fit in it.
+     * @throw unsupported_operation if the columns differ in size
+     * @throw std::bad_alloc, the column is left empty
+     */
+    number_vector & operator +=(const number_vector & other){
+        check_size(other);
+        const bool self = (&other == this);
+        const std::size_t n = size();
+        const std::size_t * const sa = scales.data(), * const sb = other.scales.data();
+        const std::size_t * const ob = other.offsets.data();
+        const limb * const lb = other.arena.data();
+        limb_vector rest; // limbs moved aside by out, kept outside so that its state stays in registers
+        rewriter out(*this, rest);
+        limb_vector r; // result of one value
+        limb_vector aligned; // operand of the smaller scale
+        try{
+            for (std::size_t i = 0; i < n; ++i){
+                std::size_t an;
+                const limb * a = out.load(i, an);
+                // the offsets of other are being rewritten if it is this column
+                const limb * b = self ? a : lb + ob[i];
+                const std::size_t bn = self ? an : ob[i + 1] - ob[i];
+                const std::size_t frac = std::max(sa[i], sb[i]);
+                if (an > 1 || bn > 1 || frac - std::min(sa[i], sb[i]) >= arith::digits){
+                    const limb_shape s = add_limbs(i, a, an, other, b, bn, r, aligned);
+                    out.store(i, r.data(), s.len, s.negative, s.frac);
+                    continue;
+                }
+                // single limbs, aligned and added in native integers as in number::add_small
+                dlimb x = (an != 0) ? a[0] : 0, y = (bn != 0) ? b[0] : 0;
+                if (sa[i] < frac) x *= arith::power(static_cast<unsigned>(frac - sa[i]));
+                else if (sb[i] < frac) y *= arith::power(static_cast<unsigned>(frac - sb[i]));
+                const bool na = negative[i], nb = other.negative[i], flip = (na != nb && x < y);
+                out.store_native(i, (na == nb) ? x + y : flip ? y - x : x - y, flip ? nb : na, frac);
+            }
+        }
+        catch(...){
+            clear();
+            throw;
+        }
+        out.close();
+        return *this;
+    }
+
+    /**
+     * @brief Multiplies by the values of other elementwise
+     *
+     * Products are computed from the limbs of both columns and truncated
+     * to the larger scale as number::operator*= does. Results are written
+     * back over the arena while they fit in it.
+     * @throw unsupported_operation if the columns differ in size
+     * @throw std::bad_alloc, the column is left empty
+     */
+    number_vector & operator *=(const number_vector & other){
+        check_size(other);
+        const bool self = (&other == this);
+        const std::size_t n = size();
+        const std::size_t * const sa = scales.data(), * const sb = other.scales.data();
+        const std::size_t * const ob = other.offsets.data();
+        const limb * const lb = other.arena.data();
+        limb_vector rest; // limbs moved aside by out, kept outside so that its state stays in registers
+        rewriter out(*this, rest);
+        limb_vector r; // result of one value
+        try{
+            for (std::size_t i = 0; i < n; ++i){
+                std::size_t an;
+                const limb * a = out.load(i, an);
+                // the offsets of other are being rewritten if it is this column
+                const limb * b = self ? a : lb + ob[i];
+                const std::size_t bn = self ? an : ob[i + 1] - ob[i];
+                const std::size_t dropped = std::min(sa[i], sb[i]);
+                if (an != 1 || bn != 1 || dropped >= arith::digits){
+                    const limb_shape s = mul_limbs(i, a, an, other, b, bn, r);
+                    out.store(i, r.data(), s.len, s.negative, s.frac);
+                    continue;
+                }
+                // single limbs, multiply and truncate in native integers
+                out.store_native(i, arith::div_pow(static_cast<dlimb>(a[0]) * b[0], static_cast<unsigned>(dropped)),
+                                 negative[i] != other.negative[i], std::max(sa[i], sb[i]));
+            }
+        }
+        catch(...){
+            clear();
+            throw;
+        }
+        out.close();
+        return *this;
+    }
+
+private:
+    typedef detail::limb limb;
+    typedef detail::dlimb dlimb;
+    typedef detail::limb_vector limb_vector;
+    typedef detail::limb_arith<radix> arith;
+
+    /**
+     * @brief Compares magnitudes of values i and j
+     *
+     * Values of the same scale are compared in place, single limbs whose
+     * scales differ by less than a limb in native integers, otherwise the
+     * one with less fractional digits is brought to the scale of the other
+     * in a copy, like number does.
+     */
+    int cmp_mag(std::size_t i, std::size_t j) const{
+        const limb * a = arena.data() + offsets[i];
+        const limb * b = arena.data() + offsets[j];
+        std::size_t an = offsets[i + 1] - offsets[i], bn = offsets[j + 1] - offsets[j];
+        if (an <= 1 && bn <= 1 && scales[i] != scales[j] &&
+            std::max(scales[i], scales[j]) - std::min(scales[i], scales[j]) < arith::digits){
+            dlimb x = (an != 0) ? a[0] : 0, y = (bn != 0) ? b[0] : 0;
+            if (scales[i] < scales[j]) x *= arith::power(static_cast<unsigned>(scales[j] - scales[i]));
+            else y *= arith::power(static_cast<unsigned>(scales[i] - scales[j]));
+            return (x > y) - (x < y);
+        }
+        limb_vector tmp;
+        if (scales[i] < scales[j]){
+            tmp.assign(a, a + an);
+            number<radix>::scale_up(tmp, scales[j] - scales[i]);
+            a = tmp.data();
+            an = tmp.size();
+        }
+        else if (scales[j] < scales[i]){
+            tmp.assign(b, b + bn);
+            number<radix>::scale_up(tmp, scales[i] - scales[j]);
+            b = tmp.data();
+            bn = tmp.size();
+        }
+        if (an != bn) return (an > bn) ? 1 : -1;
+        return arith::cmp_n(a, b, an);
+    }
+
+    /**
+     * @brief Index of the first value v with compare(v, others) == direction
+     */
+    std::size_t extreme_index(int direction) const{
+        if (empty()) throw(unsupported_operation("extreme of an empty number_vector"));
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < size(); ++i){
+            if (compare(i, best) * direction > 0) best = i;
+        }
+        return best;
+    }
+
+    /**
+     * @throw unsupported_operation if other differs in size
+     */
+    void check_size(const number_vector & other) const{
+        if (other.size() != size()) throw(unsupported_operation("elementwise operation on number_vectors of different sizes"));
+    }
+
+    /**
+     * @brief Divides the len limbs at r by radix^n and trims them
+     */
+    static void drop_digits(limb * r, std::size_t & len, std::size_t n){
+        if (n != 0){
+            const std::size_t whole = n / arith::digits;
+            if (whole >= len){
+                len = 0;
+                return;
+            }
+            std::copy(r + whole, r + len, r);
+            len -= whole;
+            if (n % arith::digits != 0) arith::divrem_pow(r, r, len, static_cast<unsigned>(n % arith::digits));
+        }
+        while (len != 0 && r[len - 1] == 0) --len;
+    }
+
+    /**
+     * @brief Cuts the dropped lowest digits off the len limbs at r, trims
+     * them and strips trailing fractional zeroes as number::strip_zeroes does
+     */
+    static void normalize(limb * r, std::size_t & len, bool & neg, std::size_t & frac, std::size_t dropped){
+        drop_digits(r, len, dropped);
+        if (len == 0){
+            // zero is positive
+            neg = false;
+            frac = 0;
+            return;
+        }
+        if (len == 1){
+            // the trailing zeroes are all in this limb
+            for (; frac != 0 && r[0] % radix == 0; --frac) r[0] /= radix;
+            return;
+        }
+        std::size_t zeroes = 0, i = 0;
+        while (zeroes + arith::digits <= frac && r[i] == 0){
+            zeroes += arith::digits;
+            ++i;
+        }
+        for (limb x = r[i]; zeroes < frac && x % radix == 0; x /= radix){
+            ++zeroes;
+        }
+        drop_digits(r, len, zeroes);
+        frac -= zeroes;
+    }
+
+    /**
+     * @brief Replaces the values of a column in order, in place while the results fit
+     *
+     * Value i is loaded before its result is stored. Results are written
+     * over limbs that were already loaded, the first result that does not
+     * fit moves the limbs not loaded yet aside and later results are appended.
+     */
+    class rewriter{
+    public:
+        rewriter(number_vector & column, limb_vector & aside):
+            v(column),
+            rest(aside),
+            shift(0),
+            spilled(false),
+            start(0),
+            end(0),
+            written(0)
+        {}
+
+        /**
+         * @brief Limbs of value i, n is set to their count
+         */
+        const limb * load(std::size_t i, std::size_t & n){
+            start = end;
+            end = v.offsets[i + 1];
+            n = end - start;
+            return spilled ? rest.data() + (start - shift) : v.arena.data() + start;
+        }
+
+        /**
+         * @brief Stores the len limbs at r as value i, r must not point into the arena
+         */
+        void store(std::size_t i, const limb * r, std::size_t len, bool neg, std::size_t frac){
+            if (spilled || written + len > end) grow(len);
+            limb * const to = v.arena.data() + written;
+            for (std::size_t k = 0; k < len; ++k) to[k] = r[k];
+            written += len;
+            v.offsets[i + 1] = written;
+            v.negative[i] = neg;
+            v.scales[i] = frac;
+        }
+
+        /**
+         * @brief Stores the magnitude x < base^2 computed in native integers as value i
+         */
+        void store_native(std::size_t i, dlimb x, bool neg, std::size_t frac){
+            if (x >= arith::base){
+                store_wide(i, x, neg, frac);
+                return;
+            }
+            // a single limb, trailing zeroes are stripped in native integers
+            limb r = static_cast<limb>(x);
+            for (; frac != 0 && r % radix == 0; --frac) r /= radix;
+            store(i, &r, (r != 0) ? 1 : 0, neg && r != 0, frac);
+        }
+
+        /**
+         * @brief Cuts the arena after the last stored value
+         */
+        void close(){
+            v.arena.resize(written);
+        }
+
+    private:
+        /**
+         * @brief Stores the magnitude base <= x < base^2 as value i
+         */
+        void store_wide(std::size_t i, dlimb x, bool neg, std::size_t frac){
+            limb r[2];
+            std::size_t len = 2;
+            r[1] = arith::divmod_base(x, r[0]);
+            normalize(r, len, neg, frac, 0);
+            store(i, r, len, neg, frac);
+        }
+
+        /**
+         * @brief Makes room for len limbs after the stored values
+         */
+        void grow(std::size_t len){
+            if (!spilled){
+                rest.assign(v.arena.begin() + end, v.arena.end());
+                shift = end;
+                spilled = true;
+            }
+            v.arena.resize(written + len);
+        }
+
+        number_vector & v;
+        limb_vector & rest;  // limbs not loaded yet once a result did not fit
+        std::size_t shift;   // position of rest[0] in the original arena
+        bool spilled;
+        std::size_t start;   // limbs of the last loaded value in the original arena
+        std::size_t end;
+        std::size_t written; // end of the stored values in the arena
+    };
+
+    /**
+     * @brief Length, sign and scale of a result computed into a limb_vector
+     */
+    struct limb_shape{
+        std::size_t len;
+        bool negative;
+        std::size_t frac;
+    };
+
+    /**
+     * @brief Computes value i plus value i of other, given by their limbs,
+     * into r, aligned is scratch space
+     */
+    limb_shape add_limbs(std::size_t i, const limb * a, std::size_t an,
+                         const number_vector & other, const limb * b, std::size_t bn,
+                         limb_vector & r, limb_vector & aligned) const{
+        std::size_t frac = std::max(scales[i], other.scales[i]);
+        if (scales[i] < frac){
+            aligned.assign(a, a + an);
+            number<radix>::scale_up(aligned, frac - scales[i]);
+            a = aligned.data();
+            an = aligned.size();
+        }
+        else if (other.scales[i] < frac){
+            aligned.assign(b, b + bn);
+            number<radix>::scale_up(aligned, frac - other.scales[i]);
+            b = aligned.data();
+            bn = aligned.size();
+        }
+        bool na = negative[i], nb = other.negative[i];
+        if (an < bn){
+            std::swap(a, b);
+            std::swap(an, bn);
+            std::swap(na, nb);
+        }
+        r.resize(an + 1);
+        bool neg = na;
+        if (na == nb){
+            r[an] = arith::add(r.data(), a, an, b, bn);
+        }
+        else{
+            // the magnitude with more limbs is the larger one
+            if (an != bn || arith::cmp_n(a, b, an) >= 0){
+                arith::sub(r.data(), a, an, b, bn);
+            }
+            else{
+                arith::sub(r.data(), b, bn, a, an);
+                neg = nb;
+            }
+            r[an] = 0;
+        }
+        std::size_t len = an + 1;
+        normalize(r.data(), len, neg, frac, 0);
+        return limb_shape{len, neg, frac};
+    }
+
+    /**
+     * @brief Computes value i times value i of other, given by their limbs, into r
+     */
+    limb_shape mul_limbs(std::size_t i, const limb * a, std::size_t an,
+                         const number_vector & other, const limb * b, std::size_t bn, limb_vector & r) const{
+        if (an == 0 || bn == 0) return limb_shape{0, false, 0};
+        bool neg = (negative[i] != other.negative[i]);
+        std::size_t frac = std::max(scales[i], other.scales[i]);
+        std::size_t len = an + bn;
+        r.resize(len);
+        arith::mul(r.data(), a, an, b, bn);
+        normalize(r.data(), len, neg, frac, std::min(scales[i], other.scales[i]));
+        return limb_shape{len, neg, frac};
+    }
+
+    limb_vector arena;                   // limbs of all values, least significant first
+    std::vector<std::size_t> offsets;    // value i spans [offsets[i], offsets[i+1]) of arena
+    std::vector<unsigned char> negative; // sign of value i
+    std::vector<std::size_t> scales;     // fractional digits of value i
+};
+
+template<unsigned char radix>
+number_vector<radix> operator +(const number_vector<radix> & lhs, const number_vector<radix> & rhs){
+    number_vector<radix> newvec(lhs);
+    newvec+=rhs;
+    return newvec;
+}
+
+template<unsigned char radix>
+number_vector<radix> operator *(const number_vector<radix> & lhs, const number_vector<radix> & rhs){
+    number_vector<radix> newvec(lhs);
+    newvec*=rhs;
+    return newvec;
+}
+
 // Common radix typedefs:
 #if MAX_RADIX>=2
 using binary = number<2>;
@@ -1569,6 +5859,35 @@ fixedpoint::number<radix> trunc(const fixedpoint::number<radix> & num){
     return result;
 }
 
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixedpoint::fixed_number<radix, WholeDigits, FracDigits> pow(const fixedpoint::fixed_number<radix, WholeDigits, FracDigits> & base,
+                     const fixedpoint::fixed_number<radix, WholeDigits, FracDigits> & exponent){
+    fixedpoint::fixed_number<radix, WholeDigits, FracDigits> result(base);
+    result.pow(exponent);
+    return result;
+}
+
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixedpoint::fixed_number<radix, WholeDigits, FracDigits> floor(const fixedpoint::fixed_number<radix, WholeDigits, FracDigits> & num){
+    fixedpoint::fixed_number<radix, WholeDigits, FracDigits> result(num);
+    result.floor();
+    return result;
+}
+
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixedpoint::fixed_number<radix, WholeDigits, FracDigits> ceil(const fixedpoint::fixed_number<radix, WholeDigits, FracDigits> & num){
+    fixedpoint::fixed_number<radix, WholeDigits, FracDigits> result(num);
+    result.ceil();
+    return result;
+}
+
+template<unsigned char radix, std::size_t WholeDigits, std::size_t FracDigits>
+fixedpoint::fixed_number<radix, WholeDigits, FracDigits> trunc(const fixedpoint::fixed_number<radix, WholeDigits, FracDigits> & num){
+    fixedpoint::fixed_number<radix, WholeDigits, FracDigits> result(num);
+    result.trunc();
+    return result;
+}
+
 } // namespace std
 #endif // FIXEDPOINT_H
 
@@ -7,6 +7,8 @@
 #include <fixedpoint.h>
 
 #include <string>
+#include <thread>
+#include <vector>
 
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
@@ -164,3 +166,290 @@ TEST_CASE("Trunc"){
     REQUIRE( std::trunc(d) == bdexp );
 
 }
+
+TEST_CASE("Long operands"){
+    decimal a("9876543210987654321098765432109876543210.987654321");
+    const decimal b("1234567890123456789012345.6789");
+    const decimal sum("9876543210987655555666655555566665555556.666554321");
+    const decimal diff("9876543210987653086530875308653087530865.308754321");
+    const decimal prod("12193263113702179522618503273374485596337448559633622923332237463.801111263");
+    const decimal quot("8000000072900000.66339000603685705493");
+    const decimal rem("6665.802300666481464634558023");
+    REQUIRE( a+b == sum );
+    REQUIRE( a-b == diff );
+    REQUIRE( b-a == -1*diff );
+    REQUIRE( a*b == prod );
+    decimal::scale = 20;
+    REQUIRE( a/b == quot );
+    decimal::scale = 20;
+    REQUIRE( a%b == rem );
+    decimal::scale = 0;
+    a -= a;
+    REQUIRE( a == decimal(0) );
+}
+
+TEST_CASE("Multiplication of large operands"){
+    // (radix^n - 1)^2 == radix^2n - 2*radix^n + 1
+    for (std::size_t n : {500, 2000, 6000}){
+        const decimal nines(std::string(n, '9'));
+        const decimal square(std::string(n-1, '9') + "8" + std::string(n-1, '0') + "1");
+        REQUIRE( nines*nines == square );
+        const hexadecimal fs(std::string(n, 'f'));
+        const hexadecimal hsquare(std::string(n-1, 'f') + "e" + std::string(n-1, '0') + "1");
+        REQUIRE( fs*fs == hsquare );
+    }
+    std::string digitsA, digitsB;
+    for (std::size_t i = 0; i < 9000; ++i){
+        digitsA.push_back('0' + (i*7 + i/11) % 10);
+        digitsB.push_back('0' + (i*3 + i/5) % 10);
+    }
+    const decimal a(digitsA + "." + digitsB.substr(0, 700)), b(digitsB.substr(0, 8000));
+    REQUIRE( (a+b)*(a-b) == a*a - b*b );
+}
+
+TEST_CASE("Multiplication of huge operands"){
+    const std::size_t n = 80000;
+    const decimal nines(std::string(n, '9'));
+    const decimal square(std::string(n-1, '9') + "8" + std::string(n-1, '0') + "1");
+    REQUIRE( nines*nines == square );
+    const number<36> zs(std::string(n, 'z'));
+    const number<36> zsquare(std::string(n-1, 'z') + "y" + std::string(n-1, '0') + "1");
+    REQUIRE( zs*zs == zsquare );
+    std::string digitsA, digitsB;
+    for (std::size_t i = 0; i < n; ++i){
+        digitsA.push_back('0' + (i*7 + i/11) % 10);
+        digitsB.push_back('0' + (i*3 + i/5) % 10);
+    }
+    const decimal a(digitsA), b(digitsB + digitsB.substr(0, n/2));
+    REQUIRE( (a+b)*(a-b) == a*a - b*b );
+}
+
+TEST_CASE("Division of large operands"){
+    std::string digitsA, digitsB;
+    for (std::size_t i = 0; i < 3000; ++i){
+        digitsA.push_back('1' + (i*7 + i/11) % 9);
+        digitsB.push_back('0' + (i*3 + i/5) % 10);
+    }
+    const decimal a(digitsA), b(digitsB.substr(0, 1700)), r(digitsB.substr(1700, 1500));
+    REQUIRE( (a*b + r)/b == a );
+    REQUIRE( (a*b + r)%b == r );
+    REQUIRE( (a*b - r)%b == b - r );
+    const number<36> za(std::string(900, 'z')), zb("1" + std::string(400, '0'));
+    REQUIRE( za/zb == number<36>(std::string(500, 'z')) );
+    REQUIRE( za%zb == number<36>(std::string(400, 'z')) );
+}
+
+TEST_CASE("Division of huge operands"){
+    const std::size_t n = 40000;
+    std::string digitsA, digitsB;
+    for (std::size_t i = 0; i < n; ++i){
+        digitsA.push_back('1' + (i*7 + i/11) % 9);
+        digitsB.push_back('0' + (i*3 + i/5) % 10);
+    }
+    const decimal a(digitsA), b(digitsB.substr(0, n/2)), r(digitsB.substr(n/2, n/3));
+    REQUIRE( (a*b + r)/b == a );
+    REQUIRE( (a*b + r)%b == r );
+    std::string sevenths("0.");
+    for (std::size_t i = 0; i < n/6; ++i) sevenths += "142857";
+    decimal::scale = 6*(n/6);
+    REQUIRE( decimal(1)/decimal(7) == decimal(sevenths) );
+    // 1/(10^m + 1) == 10^-m - 10^-2m + 10^-3m - ...
+    decimal::scale = n;
+    const decimal tenpow("1" + std::string(n/2, '0'));
+    REQUIRE( 1/(tenpow + 1) == decimal("0." + std::string(n/2, '0') + std::string(n/2, '9')) );
+    decimal::scale = 0;
+}
+
+TEST_CASE("Self multiplication"){
+    decimal a("-12.5");
+    a *= a;
+    REQUIRE( a == decimal("156.2") );
+    for (std::size_t n : {5, 60, 700, 5000}){
+        std::string digits;
+        for (std::size_t i = 0; i < n; ++i) digits.push_back('0' + (i*7 + i/3) % 10);
+        decimal x(digits + "." + digits.substr(0, n/2));
+        const decimal copy(x);
+        x *= x;
+        REQUIRE( x == copy*decimal(copy) );
+        number<36> z(std::string(n, 'z'));
+        z *= z;
+        REQUIRE( z == number<36>(std::string(n-1, 'z') + "y" + std::string(n-1, '0') + "1") );
+    }
+}
+
+TEST_CASE("Integral operands"){
+    decimal a("-54.2564"), b("0.75");
+    REQUIRE( a + 7 == decimal("-47.2564") );
+    REQUIRE( 7 + a == decimal("-47.2564") );
+    REQUIRE( a - 100 == decimal("-154.2564") );
+    REQUIRE( 100 - a == decimal("154.2564") );
+    REQUIRE( a * -3 == decimal("162.7692") );
+    REQUIRE( b * 4 == decimal(3) );
+    REQUIRE( a * 0 == decimal(0) );
+    decimal::scale = 3;
+    REQUIRE( a / 7 == decimal("-7.750") );
+    REQUIRE( a / -7LL == decimal("7.750") );
+    decimal::scale = 3;
+    REQUIRE( a % 7 == decimal("-0.0064") );
+    decimal::scale = 0;
+    REQUIRE( a % 7 == decimal("-5.2564") );
+    REQUIRE_THROWS_AS( a / 0, const division_by_zero & );
+    // values that don't fit into a single limb:
+    REQUIRE( decimal(1) + 9223372036854775807LL == decimal("9223372036854775808") );
+    REQUIRE( decimal("0.5") * -9223372036854775807LL == decimal("-4611686018427387903.5") );
+    // crossing zero with increments:
+    --b;
+    REQUIRE( b == decimal("-0.25") );
+    ++b;
+    ++b;
+    REQUIRE( b == decimal("1.75") );
+    number<7> c("-0.1");
+    c += 1;
+    REQUIRE( c == number<7>("0.6") );
+    c -= 1u;
+    REQUIRE( c == number<7>("-0.1") );
+}
+
+TEST_CASE("Scale guard"){
+    decimal::scale = 2;
+    const decimal a(1), b(3);
+    {
+        decimal::scale_guard outer(5);
+        REQUIRE( decimal::current_scale() == 5 );
+        REQUIRE( a/b == decimal("0.33333") );
+        {
+            decimal::scale_guard inner(1);
+            REQUIRE( a/b == decimal("0.3") );
+            REQUIRE( decimal("2.5").pow(decimal(-1)) == decimal("0.4") );
+        }
+        REQUIRE( a%b == decimal("0.00001") );
+        REQUIRE( a/b == decimal("0.33333") );
+    }
+    REQUIRE( decimal::current_scale() == 2 );
+    // modulo and pow leave the scale alone:
+    REQUIRE( decimal("7.125") % 2 == decimal("0.005") );
+    REQUIRE( decimal(3).pow(decimal(5)) == decimal(243) );
+    REQUIRE( decimal::scale == 2 );
+    REQUIRE( a/b == decimal("0.33") );
+
+    std::vector<decimal> results(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < results.size(); ++i){
+        threads.emplace_back([i, &results](){
+            decimal::scale_guard precision(10*i);
+            decimal x(0);
+            for (int j = 0; j < 200; ++j){
+                x = decimal(1)/decimal(7);
+                x.pow(decimal(1));
+            }
+            results[i] = x;
+        });
+    }
+    for (auto & t : threads) t.join();
+    REQUIRE( results[0] == decimal(0) );
+    REQUIRE( results[1] == decimal("0.1428571428") );
+    REQUIRE( results[3] == decimal("0.142857142857142857142857142857") );
+    decimal::scale = 0;
+}
+
+TEST_CASE("Small operands"){
+    // crossing limb boundaries in both directions
+    decimal a("999999999999999999.5"), b("0.5");
+    REQUIRE( a + b == decimal("1000000000000000000") );
+    REQUIRE( a - b == decimal("999999999999999999") );
+    REQUIRE( -1*a - b == decimal("-1000000000000000000") );
+    REQUIRE( b - a == decimal("-999999999999999999") );
+    REQUIRE( a*a == decimal("999999999999999999000000000000000000.2") );
+    decimal c(a*a*a);
+    REQUIRE( c == decimal("999999999999999998500000000000000000699999999999999999.9") );
+    c -= decimal("999999999999999998500000000000000000699999999999999999.8");
+    REQUIRE( c == decimal("0.1") );
+    REQUIRE( decimal("0.001") * decimal("0.002") == decimal(0) );
+    REQUIRE( decimal("1.25") * decimal("-0.8") == decimal(-1) );
+    const number<2> x("111111111111111111111111111111111111111111111111111111111111111.1");
+    REQUIRE( x + number<2>("0.1") == number<2>("1" + std::string(63, '0')) );
+    REQUIRE( x*x == number<2>(std::string(63, '1') + std::string(63, '0')) );
+}
+
+TEST_CASE("Power of two radices"){
+    // scaling by powers of radix crosses limb boundaries
+    const octal a("7654321076543210765.4321076543210765432107"), b("-0.0000000000000000000001");
+    REQUIRE( a * b == octal("-0.0007654321076543210765") );
+    {
+        octal::scale_guard guard(30);
+        REQUIRE( a / b == octal("-76543210765432107654321076543210765432107") );
+        REQUIRE( octal(1) / b == octal("-10000000000000000000000") );
+    }
+    const number<4> c("3210321032103210321032103210321.0123"), d("1.3333333333333333333333333333333");
+    REQUIRE( c * d == number<4>("13021302130213021302130213021301.1101012301230123012301230123012") );
+    {
+        number<4>::scale_guard guard(40);
+        REQUIRE( c / d == number<4>("1302130213021302130213021302130.3012232103210321032103210321032120311302") );
+        REQUIRE( number<4>(1) / d == number<4>("0.20000000000000000000000000000001") );
+    }
+    const number<32> e("vutsrqponmlkjihgf.edcba987654321"), f("0.000000000001");
+    REQUIRE( e * f == number<32>("vutsr.qponmlkjihgfed") );
+    {
+        number<32>::scale_guard guard(13);
+        REQUIRE( e / f == number<32>("vutsrqponmlkjihgfedcba9876543.21") );
+        REQUIRE( number<32>(1) / f == number<32>("1000000000000") );
+    }
+}
+
+TEST_CASE("Columnar vectors"){
+    const std::vector<decimal> values{decimal("12.5"), decimal("-2.25"), decimal(0),
+            decimal("123456789012345678901234567890.000001"), decimal("-0.5"),
+            decimal("-123456789012345678901234567890")};
+    number_vector<10> column(values.cbegin(), values.cend());
+    REQUIRE( column.size() == values.size() );
+    decimal expected(0), read(42);
+    for (std::size_t i = 0; i < values.size(); ++i){
+        REQUIRE( column[i].str() == values[i].str() );
+        column.get(i, read);
+        REQUIRE( read == values[i] );
+        expected += values[i];
+    }
+    REQUIRE( column.sum() == expected );
+    REQUIRE( column.sum() == decimal("9.750001") );
+    REQUIRE( column.min() == values[5] );
+    REQUIRE( column.max_index() == 3 );
+    REQUIRE( column.compare(0, 1) > 0 );
+    REQUIRE( column.compare(1, 4) < 0 );
+    REQUIRE( column.compare(2, 2) == 0 );
+
+    number_vector<10> other;
+    for (const auto & v : values) other.push_back(v * decimal("-1.5"));
+    const number_vector<10> added = column + other, multiplied = column * other;
+    for (std::size_t i = 0; i < values.size(); ++i){
+        REQUIRE( added[i].str() == (values[i] + other[i]).str() );
+        REQUIRE( multiplied[i].str() == (values[i] * other[i]).str() );
+    }
+    // the same scales, results cancel, change sign and lose fractional digits:
+    const std::vector<decimal> same{decimal("-12.5"), decimal("2.75"), decimal(1),
+            decimal("-123456789012345678901234567890.000009"), decimal("0.5"),
+            decimal("123456789012345678901234567891")};
+    const number_vector<10> shifted(same.cbegin(), same.cend());
+    const number_vector<10> sums = column + shifted, products = column * shifted;
+    for (std::size_t i = 0; i < values.size(); ++i){
+        REQUIRE( sums[i].str() == (values[i] + same[i]).str() );
+        REQUIRE( products[i].str() == (values[i] * same[i]).str() );
+    }
+    REQUIRE( sums[1] == decimal("0.5") );
+    REQUIRE( sums[3] == decimal("-0.000008") );
+    REQUIRE( sums[5] == decimal(1) );
+    // in place on itself, the growing results no longer fit their limbs:
+    number_vector<10> squares(column);
+    squares += squares;
+    squares *= squares;
+    for (std::size_t i = 0; i < values.size(); ++i){
+        REQUIRE( squares[i].str() == ((values[i] + values[i]) * (values[i] + values[i])).str() );
+    }
+    REQUIRE_THROWS_AS( column += number_vector<10>(), const unsupported_operation & );
+    REQUIRE( number_vector<10>().sum() == decimal(0) );
+    REQUIRE_THROWS_AS( number_vector<10>().max(), const unsupported_operation & );
+
+    column.clear();
+    REQUIRE( column.empty() );
+    column.push_back(decimal("-0.75"));
+    REQUIRE( column.sum() == decimal("-0.75") );
+}
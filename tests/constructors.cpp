@@ -7,6 +7,7 @@
 #include <fixedpoint.h>
 
 #include <string>
+#include <thread>
 
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
@@ -93,6 +94,175 @@ TEST_CASE("String constructor"){
     REQUIRE( n12.str() == "12::-5ab.841b"s );
 }
 
+TEST_CASE("Long string constructor across radices"){
+    const hexadecimal n1("10::1"s + std::string(3000, '0'));
+    REQUIRE( n1 == std::pow(hexadecimal(10), hexadecimal(3000)) );
+    const decimal n2("16::"s + std::string(2000, 'f'));
+    REQUIRE( n2 == std::pow(decimal(16), decimal(2000)) - 1 );
+    const decimal n3("2::0."s + std::string(1000, '0') + "1", 1000);
+    decimal::scale = 1000;
+    REQUIRE( n3 == decimal(1) / std::pow(decimal(2), decimal(1001)) );
+    decimal::scale = 0;
+}
+
+TEST_CASE("Long digit strings"){
+    const std::string nines(70, '9');
+    REQUIRE( decimal(nines) == std::pow(decimal(10), decimal(70)) - 1 );
+    REQUIRE( hexadecimal(std::string(40, 'f') + "." + std::string(30, 'a')).str()
+             == "16::"s + std::string(40, 'f') + "." + std::string(30, 'a') );
+#if defined(FIXEDPOINT_CASE_INSENSITIVE)
+    REQUIRE( hexadecimal(std::string(40, 'F') + "." + std::string(30, 'a')).str()
+             == "16::"s + std::string(40, 'f') + "." + std::string(30, 'a') );
+#endif
+    // the radix point and an invalid character at every position:
+    for (std::size_t i = 0; i < nines.size(); ++i){
+        std::string split = nines;
+        split.insert(i, ".");
+        REQUIRE( decimal(split).str() == "10::"s + (i == 0 ? "0" : nines.substr(0, i)) + "." + nines.substr(i) );
+        std::string bad = nines;
+        bad[i] = 'a';
+        REQUIRE_THROWS_AS( decimal("10::" + bad), const invalid_number_format & );
+        bad[i] = '.';
+        bad[nines.size() - 1 - i] = ',';
+        REQUIRE_THROWS_AS( decimal("10::" + bad), const invalid_number_format & );
+    }
+}
+
+TEST_CASE("Floating point constructor"){
+    REQUIRE( decimal(3.14159) == decimal("3.14159") );
+    REQUIRE( decimal(-0.001, 2).str() == "10::0"s );
+    REQUIRE( decimal(0.1, -1).str() == "10::0.1000000000000000055511151231257827021181583404541015625"s );
+    REQUIRE( decimal(1e20) == decimal("100000000000000000000") );
+    decimal::scale = 1074;
+    REQUIRE( decimal(std::ldexp(1.0, -1074), -1) == decimal(1) / std::pow(decimal(2), decimal(1074)) );
+    decimal::scale = 0;
+    // rounding to nearest, ties to even:
+    REQUIRE( decimal(2.5, 0) == decimal(2) );
+    REQUIRE( decimal(3.5, 0) == decimal(4) );
+    REQUIRE( decimal(-2.5, 0).str() == "10::-2"s );
+    REQUIRE( decimal(0.125, 2).str() == "10::0.12"s );
+    REQUIRE( number<3>(0.5, 4).str() == "3::0.1111"s );
+    REQUIRE( binary(0.75).str() == "2::0.11"s );
+    REQUIRE( hexadecimal(-255.5f, 3).str() == "16::-ff.8"s );
+    REQUIRE( octal(1.0L / 3, 10).str() == "8::0.2525252525"s );
+    REQUIRE_THROWS_AS( decimal(std::numeric_limits<double>::infinity()), const unsupported_operation & );
+    REQUIRE_THROWS_AS( decimal(std::nan("")), const unsupported_operation & );
+}
+
+TEST_CASE("Conversion to native types"){
+    REQUIRE( static_cast<double>(decimal("3.14159")) == 3.14159 );
+    REQUIRE( static_cast<double>(decimal("-0.1")) == -0.1 );
+    REQUIRE( static_cast<float>(hexadecimal("-ff.8")) == -255.5f );
+    REQUIRE( static_cast<double>(decimal("123456789012345678901234567890.123456789")) == 123456789012345678901234567890.123456789 );
+    REQUIRE( static_cast<double>(decimal("10::1" + std::string(300, '0'))) == 1e300 );
+    REQUIRE( static_cast<double>(decimal("0." + std::string(320, '0') + "5")) == 5e-321 );
+    // halfway between 1 and the next double, rounded to even unless a digit follows:
+    const std::string half = "1.00000000000000011102230246251565404236316680908203125";
+    REQUIRE( static_cast<double>(decimal(half)) == 1.0 );
+    REQUIRE( static_cast<double>(decimal(half + std::string(100, '0') + "1")) == 1.0000000000000002 );
+    REQUIRE( static_cast<double>(decimal(0.1, -1)) == 0.1 );
+    REQUIRE( static_cast<double>(number<3>(0.1, -1)) == 0.1 );
+
+    REQUIRE( static_cast<int>(decimal("-12.9")) == -12 );
+    REQUIRE( static_cast<std::int64_t>(decimal("-9223372036854775808.5")) == INT64_MIN );
+    REQUIRE( static_cast<std::uint64_t>(hexadecimal("ffffffffffffffff.f")) == UINT64_MAX );
+    const unsigned __int128 big = static_cast<unsigned __int128>(decimal("340282366920938463463374607431768211455"));
+    REQUIRE( (big == ~static_cast<unsigned __int128>(0)) );
+    REQUIRE( (static_cast<__int128>(decimal("-1" + std::string(38, '0'))) / static_cast<__int128>(1e19) == -static_cast<__int128>(1e19)) );
+
+    std::int64_t i = 7;
+    REQUIRE( to_native(decimal("9223372036854775808"), i) == std::errc::result_out_of_range );
+    REQUIRE( i == 7 );
+    unsigned u = 7;
+    REQUIRE( to_native(decimal("-1"), u) == std::errc::result_out_of_range );
+    REQUIRE( to_native(decimal("-0.5"), u) == std::errc() );
+    REQUIRE( u == 0 );
+    double d;
+    REQUIRE( to_native(decimal("-1" + std::string(400, '0')), d) == std::errc::result_out_of_range );
+    REQUIRE( d == -std::numeric_limits<double>::infinity() );
+    REQUIRE_THROWS_AS( static_cast<float>(decimal("1" + std::string(40, '0'))), const number_overflow & );
+    REQUIRE_THROWS_AS( static_cast<short>(decimal(40000)), const number_overflow & );
+}
+
+TEST_CASE("Conversion between radices"){
+    REQUIRE( decimal::convert(hexadecimal("-1f3a9c44d2e8.8b")).str() == "10::-34336590320360.5429"s );
+    REQUIRE( hexadecimal::convert(decimal("12345678901234567890123.0625")).str() == "16::29d42b64e76714244cb.1"s );
+    REQUIRE( number<3>::convert(binary("101.1")).str() == "3::12.1"s );
+    REQUIRE( binary::convert(number<36>("zz.z")).str() == "2::10100001111.11111000111000111"s );
+    REQUIRE( decimal::convert(duodecimal(0)).str() == "10::0"s );
+    const hexadecimal big("10::"s + std::string(2000, '9') + "." + std::string(300, '3'));
+    REQUIRE( hexadecimal::convert(decimal("10::"s + std::string(2000, '9') + "." + std::string(300, '3'))) == big );
+    REQUIRE( decimal::convert(hexadecimal::convert(decimal(-987654321))) == decimal(-987654321) );
+}
+
+TEST_CASE("Conversion between powers of a common root"){
+    REQUIRE( hexadecimal::convert(binary("-0.0001")).str() == "16::-0.1"s );
+    REQUIRE( binary::convert(hexadecimal("f.f")).str() == "2::1111.1111"s );
+    REQUIRE( number<32>::convert(octal("7.7")).str() == "32::7.s"s );
+    REQUIRE( number<27>::convert(number<3>("12.2")).str() == "27::5.i"s );
+    REQUIRE( number<3>::convert(number<9>("-88.1")).str() == "3::-2222.01"s );
+    REQUIRE( number<2>("16::f.f", 2).str() == "2::1111.11"s );
+    REQUIRE( number<4>("-32::v.v").str() == "4::-133.332"s );
+    const std::string bits = "1011" + std::string(500, '0') + "1." + std::string(300, '1');
+    REQUIRE( binary::convert(number<32>::convert(binary(bits))) == binary(bits) );
+    REQUIRE( octal::convert(binary(bits)) == octal("2::" + bits) );
+}
+
+TEST_CASE("Cached radix powers"){
+    const std::string digits = "10::"s + std::string(5000, '7') + "." + std::string(2000, '1');
+    const hexadecimal expected(digits);
+    clear_power_cache();
+    REQUIRE( power_cache_usage() == 0 );
+    REQUIRE( hexadecimal(digits) == expected );
+    const std::size_t used = power_cache_usage();
+    REQUIRE( used > 0 );
+    REQUIRE( used <= power_cache_limit() );
+    REQUIRE( hexadecimal(digits) == expected );
+    REQUIRE( power_cache_usage() == used );
+
+    std::vector<std::thread> threads;
+    bool equal[4];
+    for (int i = 0; i < 4; ++i){
+        threads.emplace_back([&digits, &expected, &equal, i](){
+            equal[i] = (hexadecimal(digits) == expected) && (hexadecimal::convert(decimal(digits)) == expected);
+        });
+    }
+    for (auto & t : threads) t.join();
+    REQUIRE( (equal[0] && equal[1] && equal[2] && equal[3]) );
+
+    // conversions of different lengths racing to fill an empty cache:
+    std::vector<hexadecimal> lengths;
+    for (std::size_t i = 0; i < 4; ++i) lengths.push_back(hexadecimal(digits.substr(0, 1004 + 1300 * i)));
+    clear_power_cache();
+    threads.clear();
+    for (std::size_t i = 0; i < 4; ++i){
+        threads.emplace_back([&digits, &lengths, &equal, i](){
+            equal[i] = (hexadecimal(digits.substr(0, 1004 + 1300 * i)) == lengths[i]);
+        });
+    }
+    for (auto & t : threads) t.join();
+    REQUIRE( (equal[0] && equal[1] && equal[2] && equal[3]) );
+
+    // a shorter table stored after a longer one leaves the cache as it is:
+    clear_power_cache();
+    detail::power_cache::table powers(1, std::make_shared<const detail::limb_vector>(1, 1000));
+    for (int i = 0; i < 4; ++i) powers.push_back(std::make_shared<const detail::limb_vector>(2, 1));
+    detail::power_cache::instance().put(10, 3, powers);
+    const std::size_t longer = power_cache_usage();
+    REQUIRE( longer > 0 );
+    detail::power_cache::instance().put(10, 3, detail::power_cache::table(powers.begin(), powers.begin() + 2));
+    REQUIRE( power_cache_usage() == longer );
+    REQUIRE( detail::power_cache::instance().get(10, 3).size() == powers.size() );
+    clear_power_cache();
+
+    const std::size_t limit = power_cache_limit();
+    set_power_cache_limit(0);
+    REQUIRE( power_cache_usage() == 0 );
+    REQUIRE( hexadecimal(digits) == expected );
+    REQUIRE( power_cache_usage() == 0 );
+    set_power_cache_limit(limit);
+}
+
 TEST_CASE("Move and copy constructors"){
     decimal cp(255),mv(-85);
     decimal n1(cp),n2(std::move(mv));
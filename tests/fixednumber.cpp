@@ -0,0 +1,172 @@
+//          Copyright Michal Pochobradský 2016.
+//          Copyright Tibor Zauko 2016.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include <fixedpoint.h>
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+using namespace fixedpoint;
+
+template<unsigned char radix>
+std::size_t number<radix>::scale = 0;
+
+// counts every allocation, fixed_number arithmetic must not make any
+static std::size_t allocations = 0;
+
+// GCC pairs the inlined free below with new and flags it as mismatched
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void * operator new(std::size_t n){
+    ++allocations;
+    if (void * p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void * p) noexcept{
+    std::free(p);
+}
+void operator delete(void * p, std::size_t) noexcept{
+    std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+using price = fixed_number<10, 12, 6>;
+using wide = fixed_number<10, 40, 30>;
+using hexfixed = fixed_number<16, 8, 4>;
+using bin = fixed_number<2, 70, 70>;
+
+TEST_CASE("Fixed construction and output"){
+    REQUIRE( price().str() == "10::0" );
+    REQUIRE( price(-42).str() == "10::-42" );
+    REQUIRE( price("12.5").str() == "10::12.5" );
+    REQUIRE( price("-0.000001").str() == "10::-0.000001" );
+    // fractional digits beyond FracDigits are truncated:
+    REQUIRE( price("1.23456789") == price("1.234567") );
+    REQUIRE( price("-0.0000001").str() == "10::0" );
+    REQUIRE( wide(INT64_MIN).str() == "10::-9223372036854775808" );
+    REQUIRE( hexfixed("-ff.8").str() == "16::-ff.8" );
+    REQUIRE( bin("-101.011") == bin(-5) - bin("0.011") );
+
+    std::stringstream stream("3.75");
+    price x;
+    stream >> x;
+    std::stringstream out;
+    out << x;
+    REQUIRE( out.str() == "10::3.75" );
+}
+
+TEST_CASE("Fixed conversions"){
+    decimal::scale = 20;
+    const decimal a("-123456789.987654321");
+    REQUIRE( decimal(price(a)) == decimal("-123456789.987654") );
+    REQUIRE( decimal(wide(a)) == a );
+    REQUIRE( wide(decimal(wide(a))) == wide(a) );
+    REQUIRE( hexadecimal(hexfixed(hexadecimal("-1a.b"))) == hexadecimal("-1a.b") );
+    REQUIRE_THROWS_AS( price(decimal("1000000000000")), const number_overflow & );
+    decimal::scale = 0;
+}
+
+TEST_CASE("Fixed arithmetic"){
+    const price a("12.5"), b(3);
+    REQUIRE( a + b == price("15.5") );
+    REQUIRE( b - a == price("-9.5") );
+    REQUIRE( a * b == price("37.5") );
+    REQUIRE( a * price(-3) == price("-37.5") );
+    REQUIRE( a / b == price("4.166666") );
+    REQUIRE( price("-12.5") / b == price("-4.166666") );
+    REQUIRE( a % b == price("0.5") );
+    REQUIRE( price("-12.5") % b == price("-0.5") );
+    REQUIRE( price("0.001") * price("0.0001") == price(0) );
+    REQUIRE( (price("0.001") * price("-0.001")).str() == "10::-0.000001" );
+
+    price x("1.5");
+    x *= x;
+    REQUIRE( x == price("2.25") );
+    REQUIRE( ++x == price("3.25") );
+    REQUIRE( x-- == price("3.25") );
+    REQUIRE( x == price("2.25") );
+
+    REQUIRE( 2 * a == price(25) );
+    REQUIRE( a - 13 == price("-0.5") );
+    REQUIRE( 100 / b == price("33.333333") );
+
+    // operands spanning several limbs:
+    const wide c("1234567890123456789012345.123456789012345678901234567891");
+    const wide d("-98765432109876.543210987654321098765");
+    REQUIRE( c * d == wide("-121932631137021795226184977875156109736.899843689862822727175975100427") );
+    REQUIRE( c / d == wide("-12499999886.093750001423822501107191585925") );
+    REQUIRE( c % d == wide("9259259400925.370495647042450938111234567891") );
+
+    REQUIRE( hexfixed("ff.8") * hexfixed(2) == hexfixed("1ff") );
+    REQUIRE( hexfixed(1) / hexfixed(3) == hexfixed("0.5555") );
+    REQUIRE( bin(1) / bin(3) * bin(3) < bin(1) );
+}
+
+TEST_CASE("Fixed arithmetic without allocation"){
+    wide w("123456789012345678.123456789012345678901234567891");
+    const wide b("-98765.4321"), a("1.5"), e(20);
+    const std::size_t before = allocations;
+    w *= b;
+    w /= b;
+    w *= w;
+    const wide p = std::pow(a, e);
+    const std::size_t made = allocations - before;
+    REQUIRE( made == 0 );
+    REQUIRE( p == wide("3325.25673007965087890625") );
+    REQUIRE( w > wide(0) );
+}
+
+TEST_CASE("Fixed comparison"){
+    const price a("-1.5"), b("0.25"), c("0.250");
+    REQUIRE( a < b );
+    REQUIRE( b > a );
+    REQUIRE( b == c );
+    REQUIRE( b <= c );
+    REQUIRE( b >= c );
+    REQUIRE( a != b );
+    REQUIRE( price("-0") == price(0) );
+}
+
+TEST_CASE("Fixed rounding and pow"){
+    REQUIRE( std::floor(price("-2.5")) == price(-3) );
+    REQUIRE( std::floor(price("2.5")) == price(2) );
+    REQUIRE( std::ceil(price("-2.5")) == price(-2) );
+    REQUIRE( std::ceil(price("-0.5")).str() == "10::0" );
+    REQUIRE( std::ceil(price("0.5")) == price(1) );
+    REQUIRE( std::trunc(price("-2.5")) == price(-2) );
+    REQUIRE( std::trunc(price("-0.5")).str() == "10::0" );
+
+    REQUIRE( std::pow(price("1.5"), price(3)) == price("3.375") );
+    REQUIRE( std::pow(price(-2), price(3)) == price(-8) );
+    REQUIRE( std::pow(price(2), price(-2)) == price("0.25") );
+    REQUIRE( std::pow(price(7), price(0)) == price(1) );
+    REQUIRE( std::pow(hexfixed(2), hexfixed(31)) == hexfixed("80000000") );
+}
+
+TEST_CASE("Fixed exceptions"){
+    const price big("999999999999.999999");
+    REQUIRE_THROWS_AS( big + price("0.000001"), const number_overflow & );
+    REQUIRE_THROWS_AS( price(0) - big - price(1), const number_overflow & );
+    REQUIRE_THROWS_AS( big * price(2), const number_overflow & );
+    REQUIRE_THROWS_AS( big / price("0.5"), const number_overflow & );
+    REQUIRE_THROWS_AS( price(1000000000000), const number_overflow & );
+    REQUIRE_THROWS_AS( std::pow(price(10), price(12)), const number_overflow & );
+    REQUIRE_THROWS_AS( price(1) / price(0), const division_by_zero & );
+    REQUIRE_THROWS_AS( price(1) % price(0), const division_by_zero & );
+    REQUIRE_THROWS_AS( std::pow(price(2), price("0.5")), const unsupported_operation & );
+    REQUIRE_THROWS_AS( price("1.2.3"), const invalid_number_format & );
+    REQUIRE( big + price(0) == big );
+    REQUIRE( std::pow(price(10), price(11)) == price(100000000000) );
+}
@@ -6,8 +6,12 @@
 
 #include <fixedpoint.h>
 
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
@@ -39,3 +43,213 @@ TEST_CASE("Input formatting"){
     REQUIRE( res1 == n1t );
     REQUIRE( res2 == n2t );
 }
+
+TEST_CASE("Streaming extraction"){
+    using std::string; using std::stringstream;
+    const string longer = "-" + string(300, '7') + "." + string(200, '1');
+    stringstream in("  12\n-16::ff.8 2::-0.0100 " + longer + " 3.25;x 10::5:7");
+    fixedpoint::decimal n(42), m;
+    in >> n;
+    REQUIRE( n == fixedpoint::decimal(12) );
+    in >> n >> m;
+    REQUIRE( n == fixedpoint::decimal("-255.5") );
+    REQUIRE( m == fixedpoint::decimal("-0.25") );
+    in >> n;
+    REQUIRE( n == fixedpoint::decimal(longer) );
+    in >> m;
+    REQUIRE( m == fixedpoint::decimal("3.25") );
+    REQUIRE( in.get() == ';' );
+    REQUIRE( !(in >> m) );
+    REQUIRE( m == fixedpoint::decimal(0) );
+    in.clear();
+    REQUIRE( in.get() == 'x' );
+    REQUIRE( in >> m );
+    REQUIRE( m == fixedpoint::decimal(5) );
+    REQUIRE( in.get() == ':' );
+    REQUIRE( in >> m );
+    REQUIRE( in.eof() );
+    REQUIRE( !(in >> m) );
+
+    // malformed input sets failbit instead of throwing:
+    for (const string bad : {"-", "abc", "99::1", "1::1", "10::", ".", "16::g", "12::"}){
+        stringstream s(bad);
+        fixedpoint::decimal d(42);
+        REQUIRE_NOTHROW( s >> d );
+        REQUIRE( s.fail() );
+        REQUIRE( d == fixedpoint::decimal(0) );
+    }
+    stringstream b("102 2::11");
+    fixedpoint::binary x;
+    REQUIRE( !(b >> x) );
+    b.clear();
+    REQUIRE( b >> x );
+    REQUIRE( x == fixedpoint::binary(3) );
+}
+
+TEST_CASE("Parsing with from_chars"){
+    using std::string;
+    const string text("-16::ff.8 rest");
+    fixedpoint::decimal n1;
+    auto r1 = fixedpoint::from_chars(text.data(), text.data() + text.size(), n1);
+    REQUIRE( r1.ec == std::errc() );
+    REQUIRE( r1.ptr == text.data() + 9 );
+    REQUIRE( n1 == fixedpoint::decimal("-255.5") );
+
+    const string digits("0012345678901234567890123456789.1230000");
+    fixedpoint::decimal n2;
+    auto r2 = fixedpoint::from_chars(digits.data(), digits.data() + digits.size(), n2);
+    REQUIRE( r2.ptr == digits.data() + digits.size() );
+    REQUIRE( n2.str() == "10::12345678901234567890123456789.123" );
+
+    const string binary("2::-0.0100,1");
+    fixedpoint::hexadecimal n3;
+    auto r3 = fixedpoint::from_chars(binary.data(), binary.data() + binary.size(), n3);
+    REQUIRE( r3.ptr == binary.data() + 10 );
+    REQUIRE( n3.str() == "16::-0.4" );
+
+    // parsing into a used value replaces it:
+    auto r5 = fixedpoint::from_chars(digits.data() + 20, digits.data() + digits.size(), n2);
+    REQUIRE( r5.ptr == digits.data() + digits.size() );
+    REQUIRE( n2.str() == "10::90123456789.123" );
+    const string fraction(".5;");
+    REQUIRE( fixedpoint::from_chars(fraction.data(), fraction.data() + 3, n2).ptr == fraction.data() + 2 );
+    REQUIRE( n2 == fixedpoint::decimal("0.5") );
+
+    // malformed input leaves the value untouched:
+    fixedpoint::decimal n4(42);
+    for (const string bad : {"", "-", "abc", "99::1", "1::1", "10::", ".", "16::g", "-.", ".x"}){
+        auto r4 = fixedpoint::from_chars(bad.data(), bad.data() + bad.size(), n4);
+        REQUIRE( r4.ec == std::errc::invalid_argument );
+        REQUIRE( r4.ptr == bad.data() );
+        REQUIRE( n4 == fixedpoint::decimal(42) );
+    }
+}
+
+TEST_CASE("Formatting with to_chars"){
+    char buffer[32];
+    const fixedpoint::decimal n1("-10::34.134");
+    auto r1 = fixedpoint::to_chars(buffer, buffer + sizeof(buffer), n1);
+    REQUIRE( r1.ec == std::errc() );
+    REQUIRE( std::string(buffer, r1.ptr) == n1.str() );
+
+    const fixedpoint::binary n2("-0.0001");
+    auto r2 = fixedpoint::to_chars(buffer, buffer + sizeof(buffer), n2);
+    REQUIRE( std::string(buffer, r2.ptr) == "2::-0.0001" );
+
+    const fixedpoint::number<36> n3(0);
+    auto r3 = fixedpoint::to_chars(buffer, buffer + sizeof(buffer), n3);
+    REQUIRE( std::string(buffer, r3.ptr) == "36::0" );
+
+    auto r4 = fixedpoint::to_chars(buffer, buffer + 10, n1);
+    REQUIRE( r4.ec == std::errc::value_too_large );
+    REQUIRE( r4.ptr - buffer == 10 );
+}
+
+TEST_CASE("Appending and bulk formatting"){
+    using std::string;
+    const fixedpoint::decimal n1("-10::34.134"), n2(0), n3("12345678901234567890123456789.5");
+    string out("values: ");
+    n1.append_to(out);
+    REQUIRE( out == "values: 10::-34.134" );
+    REQUIRE( n3.append_to(out) == "values: 10::-34.13410::12345678901234567890123456789.5" );
+    REQUIRE( n1.str_length() == n1.str().size() );
+    REQUIRE( n2.str_length() == 5 );
+
+    const std::vector<fixedpoint::decimal> column{n1, n2, n3};
+    string csv("a;");
+    fixedpoint::format_range(csv, column.cbegin(), column.cend(), ";");
+    REQUIRE( csv == "a;" + n1.str() + ";" + n2.str() + ";" + n3.str() );
+    string empty;
+    REQUIRE( fixedpoint::format_range(empty, column.cend(), column.cend(), ";").empty() );
+
+    std::stringstream stream;
+    stream << n1 << ' ' << std::setw(12) << n2 << ' ' << fixedpoint::binary(std::string(200, '1'));
+    REQUIRE( stream.str() == "10::-34.134        10::0 2::" + string(200, '1') );
+}
+
+TEST_CASE("Binary serialization"){
+    using std::string;
+    const std::vector<fixedpoint::decimal> values{fixedpoint::decimal(0), fixedpoint::decimal("-10::34.134"),
+            fixedpoint::decimal("12345678901234567890123456789.5"),
+            fixedpoint::decimal("-" + string(300, '7') + "." + string(200, '1'))};
+    string buffer;
+    for (const auto & n : values) fixedpoint::serialize(buffer, n);
+    std::size_t total = 0;
+    for (const auto & n : values) total += n.serialized_size();
+    REQUIRE( buffer.size() == total );
+    REQUIRE( values[0].serialized_size() == 4 );
+    REQUIRE( values[3].serialized_size() < values[3].str_length() / 2 );
+
+    const char * p = buffer.data();
+    for (const auto & n : values){
+        fixedpoint::decimal read(42);
+        auto r = fixedpoint::deserialize(p, buffer.data() + buffer.size(), read);
+        REQUIRE( r.ec == std::errc() );
+        REQUIRE( read.str() == n.str() );
+        p = r.ptr;
+    }
+    REQUIRE( p == buffer.data() + buffer.size() );
+
+    char small[8];
+    auto w = fixedpoint::serialize(small, small + sizeof(small), values[2]);
+    REQUIRE( w.ec == std::errc::value_too_large );
+    REQUIRE( w.ptr - small == 8 );
+
+    // truncated input, other radix or version leave the value untouched:
+    const std::size_t first = values[0].serialized_size() + values[1].serialized_size();
+    fixedpoint::decimal n(42);
+    auto r1 = fixedpoint::deserialize(buffer.data() + first, buffer.data() + first + values[2].serialized_size() - 1, n);
+    REQUIRE( r1.ec == std::errc::invalid_argument );
+    REQUIRE( r1.ptr == buffer.data() + first );
+    fixedpoint::hexadecimal h(42);
+    REQUIRE( fixedpoint::deserialize(buffer.data(), buffer.data() + buffer.size(), h).ec == std::errc::invalid_argument );
+    REQUIRE( h == fixedpoint::hexadecimal(42) );
+    string changed = buffer;
+    changed[0] = 2;
+    REQUIRE( fixedpoint::deserialize(changed.data(), changed.data() + changed.size(), n).ec == std::errc::invalid_argument );
+    REQUIRE( n == fixedpoint::decimal(42) );
+}
+
+TEST_CASE("Loading lines in bulk"){
+    using std::string;
+    const string text = "12\n-16::ff.8\r\n  3.25\t\nabc\n\n10::-0.5\n1.2.3\n7";
+    std::vector<fixedpoint::decimal> out(1, fixedpoint::decimal(5));
+    const auto errors = fixedpoint::parse_lines(text.data(), text.data() + text.size(), out, 3);
+    REQUIRE( out.size() == 9 );
+    REQUIRE( out[0] == fixedpoint::decimal(5) );
+    REQUIRE( out[1] == fixedpoint::decimal(12) );
+    REQUIRE( out[2] == fixedpoint::decimal("-255.5") );
+    REQUIRE( out[3] == fixedpoint::decimal("3.25") );
+    REQUIRE( out[4] == fixedpoint::decimal(0) );
+    REQUIRE( out[6] == fixedpoint::decimal("-0.5") );
+    REQUIRE( out[7] == fixedpoint::decimal(0) );
+    REQUIRE( out[8] == fixedpoint::decimal(7) );
+    REQUIRE( errors.size() == 3 );
+    REQUIRE( errors[0].line == 4 );
+    REQUIRE( errors[1].line == 5 );
+    REQUIRE( errors[2].line == 7 );
+    REQUIRE( errors[2].ec == std::errc::invalid_argument );
+
+    const char * path = "fixedpoint_load_lines.txt";
+    std::string lines;
+    for (int i = 0; i < 100000; ++i) lines += std::to_string(i) + "." + std::to_string(i % 7) + "\n";
+    std::ofstream(path, std::ios::binary) << lines;
+    std::vector<fixedpoint::decimal> loaded;
+    REQUIRE( fixedpoint::load_lines(path, loaded).empty() );
+    std::remove(path);
+    REQUIRE( loaded.size() == 100000 );
+    REQUIRE( loaded[99999] == fixedpoint::decimal("99999.4") );
+    REQUIRE_THROWS_AS( fixedpoint::load_lines(path, loaded), const std::system_error & );
+    // the cause of the failure is reported:
+    for (const auto & failure : {std::make_pair(path, std::errc::no_such_file_or_directory),
+                                 std::make_pair(".", std::errc::is_a_directory)}){
+        std::error_code code;
+        try{
+            fixedpoint::load_lines(failure.first, loaded);
+        }
+        catch (const std::system_error & e){
+            code = e.code();
+        }
+        REQUIRE( code == failure.second );
+    }
+}